@@ -3,9 +3,21 @@
 #include <cstdint>
 #include <chrono>
 #include <iterator>
+#include <thread>
+#include <algorithm>
+#include <vector>
+#include <fstream>
+#include <random>
+#include <string>
+#include <utility>
+#include <memory_resource>
 #include <gtest/gtest.h>
 #include <ecxx/ecxx.h>
 
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
 using namespace ecxx;
 
 struct position {
@@ -23,7 +35,85 @@ struct comp {
     int x;
 };
 
-template<typename Func>
+struct chunked_position {
+    std::uint64_t x;
+    std::uint64_t y;
+};
+
+struct float_position {
+    float x;
+    float y;
+};
+
+struct float_velocity {
+    float x;
+    float y;
+};
+
+struct soa_position {
+    float x;
+    float y;
+};
+
+struct soa_velocity {
+    float x;
+    float y;
+};
+
+template<>
+struct ecxx::component_traits<soa_position> : ecxx::default_component_traits {
+    using soa_layout = ecxx::soa_fields<&soa_position::x, &soa_position::y>;
+};
+
+template<>
+struct ecxx::component_traits<soa_velocity> : ecxx::default_component_traits {
+    using soa_layout = ecxx::soa_fields<&soa_velocity::x, &soa_velocity::y>;
+};
+
+struct stable_position {
+    std::uint64_t x;
+    std::uint64_t y;
+};
+
+template<>
+struct ecxx::component_traits<stable_position> : ecxx::default_component_traits {
+    static constexpr bool in_place_delete = true;
+};
+
+template<>
+struct ecxx::component_traits<chunked_position> : ecxx::default_component_traits {
+    static constexpr uint32_t chunk_size = 0x1000u;
+};
+
+struct name_t {
+    std::pmr::string value;
+};
+
+struct timer final {
+    timer() : start{std::chrono::system_clock::now()} {}
+
+    void elapsed() {
+        auto now = std::chrono::system_clock::now();
+        std::cout << std::chrono::duration<double>(now - start).count() << " seconds" << std::endl;
+    }
+
+private:
+    std::chrono::time_point<std::chrono::system_clock> start;
+};
+
+std::size_t resident_memory_kb() {
+#ifdef __linux__
+    std::ifstream statm{"/proc/self/statm"};
+    std::size_t size = 0u;
+    std::size_t resident = 0u;
+    statm >> size >> resident;
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) / 1024u;
+#else
+    return 0u;
+#endif
+}
+
+template<bool BulkDestroy = false, typename Func>
 void pathological(Func func) {
     world_t registry;
 
@@ -34,15 +124,29 @@ void pathological(Func func) {
         registry.assign<comp<0>>(entity);
     }
 
+    std::vector<world_t::entity_type> destroyed;
+    timer churn;
     for (auto i = 0; i < 10; ++i) {
-        registry.each([i = 0, &registry](const auto entity) mutable {
+        registry.each([i = 0, &registry, &destroyed](const auto entity) mutable {
             // note: reset is better?
-            if (!(++i % 7)) { registry.remove<position>(entity); }
-            if (!(++i % 11)) { registry.remove<velocity>(entity); }
-            if (!(++i % 13)) { registry.remove<comp<0>>(entity); }
-            if (!(++i % 17)) { registry.destroy(entity); }
+            // components could be already removed on previous passes
+            if (!(++i % 7) && registry.has<position>(entity)) { registry.remove<position>(entity); }
+            if (!(++i % 11) && registry.has<velocity>(entity)) { registry.remove<velocity>(entity); }
+            if (!(++i % 13) && registry.has<comp<0>>(entity)) { registry.remove<comp<0>>(entity); }
+            if (!(++i % 17)) {
+                if constexpr (BulkDestroy) {
+                    destroyed.push_back(entity);
+                } else {
+                    registry.destroy(entity);
+                }
+            }
         });
 
+        if constexpr (BulkDestroy) {
+            registry.destroy(destroyed.begin(), destroyed.end());
+            destroyed.clear();
+        }
+
         for (std::uint64_t j = 0; j < 50000L; j++) {
             const auto entity = registry.create();
             registry.assign<position>(entity);
@@ -50,24 +154,14 @@ void pathological(Func func) {
             registry.assign<comp<0>>(entity);
         }
     }
+    std::cout << "Churn: ";
+    churn.elapsed();
 
     func(registry, [](auto& ... comp) {
         ((comp.x = {}), ...);
     });
 }
 
-struct timer final {
-    timer() : start{std::chrono::system_clock::now()} {}
-
-    void elapsed() {
-        auto now = std::chrono::system_clock::now();
-        std::cout << std::chrono::duration<double>(now - start).count() << " seconds" << std::endl;
-    }
-
-private:
-    std::chrono::time_point<std::chrono::system_clock> start;
-};
-
 TEST(BenchmarkECXX, Construct) {
     world_t world;
 
@@ -125,6 +219,171 @@ TEST(BenchmarkECXX, ConstructManyWithComponents) {
     timer.elapsed();
 }
 
+template<typename Component>
+void assign_spike(const char* name) {
+    world_t world;
+    std::vector<world_t::entity_type> entities(4000000);
+    world.create(entities.begin(), entities.end());
+
+    std::chrono::duration<double> worst{};
+    timer timer;
+    for (auto e : entities) {
+        const auto start = std::chrono::steady_clock::now();
+        world.assign<Component>(e);
+        worst = std::max<std::chrono::duration<double>>(worst, std::chrono::steady_clock::now() - start);
+    }
+    std::cout << name << " worst assign: " << worst.count() << " seconds, total: ";
+    timer.elapsed();
+}
+
+TEST(BenchmarkECXX, AssignSpike) {
+    std::cout << "Assigning 4000000 components one by one" << std::endl;
+
+    assign_spike<position>("Contiguous");
+    assign_spike<chunked_position>("Chunked");
+}
+
+TEST(BenchmarkECXX, AssignMany) {
+    world_t world;
+    std::vector<world_t::entity_type> entities(100000);
+    world.create(entities.begin(), entities.end());
+
+    std::cout << "Tagging 100000 entities, 10 times" << std::endl;
+
+    auto test = [&world, &entities](const char* name, auto assign) {
+        std::chrono::duration<double> assign_time{};
+        for (int i = 0; i < 10; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            assign();
+            assign_time += std::chrono::steady_clock::now() - start;
+            world.remove<position>(entities.begin(), entities.end());
+        }
+        std::cout << name << assign_time.count() << " seconds" << std::endl;
+    };
+
+    test("One by one: ", [&world, &entities] {
+        for (auto e : entities) {
+            world.assign<position>(e, std::uint64_t{1u}, std::uint64_t{2u});
+        }
+    });
+
+    test("Batch: ", [&world, &entities] {
+        world.assign<position>(entities.begin(), entities.end(), position{1u, 2u});
+    });
+}
+
+TEST(BenchmarkECXX, AssignStrings) {
+    // copied pmr strings allocate from default resource, so it's counted as well during the test
+    memory_counter counter;
+    auto* upstream = std::pmr::set_default_resource(&counter);
+    {
+        world_t world{&counter};
+        std::vector<world_t::entity_type> entities(100000);
+        world.create<name_t>(entities.begin(), entities.end());
+
+        std::cout << "Replacing 100000 string components" << std::endl;
+
+        const std::pmr::string name(64u, 'x');
+        const auto allocations = counter.allocations();
+        timer timer;
+        for (auto e : entities) {
+            world.replace_or_assign<name_t>(e, std::pmr::string{name});
+        }
+        std::cout << "Allocations per component: "
+                  << static_cast<double>(counter.allocations() - allocations) / entities.size() << ", ";
+        timer.elapsed();
+    }
+    std::pmr::set_default_resource(upstream);
+}
+
+TEST(BenchmarkECXX, Signals) {
+    std::cout << "Assigning and removing 1000000 components one by one" << std::endl;
+
+    auto test = [](const char* name, auto connect) {
+        world_t world;
+        std::vector<world_t::entity_type> entities(1000000);
+        world.create(entities.begin(), entities.end());
+        std::size_t events = 0u;
+        connect(world, events);
+
+        timer timer;
+        for (auto e : entities) {
+            world.assign<position>(e);
+        }
+        for (auto e : entities) {
+            world.remove<position>(e);
+        }
+        std::cout << name;
+        timer.elapsed();
+    };
+
+    test("No listeners: ", [](world_t&, std::size_t&) {});
+    test("Construct and destroy listeners: ", [](world_t& world, std::size_t& events) {
+        auto count = +[](void* context, world_t::entity_type) {
+            ++*static_cast<std::size_t*>(context);
+        };
+        world.on_construct<position>().connect(count, &events);
+        world.on_destroy<position>().connect(count, &events);
+    });
+}
+
+TEST(BenchmarkECXX, ConstructConcurrent) {
+    const auto max_threads = std::max(4u, std::thread::hardware_concurrency());
+
+    for (auto threads_num = 1u; threads_num <= max_threads; threads_num <<= 1u) {
+        world_t world;
+        std::vector<world_t::entity_type> entities(1000000);
+        const auto per_thread = entities.size() / threads_num;
+
+        std::cout << "Constructing 1000000 entities concurrently, " << threads_num << " thread(s)" << std::endl;
+
+        timer timer;
+        world.pool().begin_concurrent();
+        std::vector<std::thread> threads;
+        for (auto t = 0u; t < threads_num; ++t) {
+            threads.emplace_back([&world, &entities, per_thread, t] {
+                const auto end = entities.begin() + (t + 1) * per_thread;
+                for (auto it = entities.begin() + t * per_thread; it != end; ++it) {
+                    *it = world.pool().allocate_concurrent();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        world.pool().end_concurrent();
+        timer.elapsed();
+    }
+}
+
+TEST(BenchmarkECXX, ConstructConcurrentBlocks) {
+    const auto max_threads = std::max(4u, std::thread::hardware_concurrency());
+
+    for (auto threads_num = 1u; threads_num <= max_threads; threads_num <<= 1u) {
+        world_t world;
+        std::vector<world_t::entity_type> entities(1000000);
+        const auto per_thread = entities.size() / threads_num;
+
+        std::cout << "Constructing 1000000 entities concurrently in blocks of 1000, " << threads_num << " thread(s)" << std::endl;
+
+        timer timer;
+        world.pool().begin_concurrent();
+        std::vector<std::thread> threads;
+        for (auto t = 0u; t < threads_num; ++t) {
+            threads.emplace_back([&world, &entities, per_thread, t] {
+                const auto end = entities.begin() + (t + 1) * per_thread;
+                for (auto it = entities.begin() + t * per_thread; it != end; it += 1000) {
+                    world.pool().allocate_concurrent(it, it + 1000);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        world.pool().end_concurrent();
+        timer.elapsed();
+    }
+}
 
 TEST(BenchmarkECXX, Destroy) {
     world_t world;
@@ -146,6 +405,138 @@ TEST(BenchmarkECXX, Destroy) {
     }
 }
 
+TEST(BenchmarkECXX, EachSparse) {
+    world_t world;
+    std::vector<world_t::entity_type> entities(1000000);
+
+    std::cout << "Iterating over 1000000 entities pool, 1 of 100 is alive" << std::endl;
+
+    world.create(entities.begin(), entities.end());
+    for (std::uint64_t i = 0; i < entities.size(); i++) {
+        if (i % 100) {
+            world.destroy(entities[i]);
+        }
+    }
+
+    std::uint64_t count = 0;
+
+    timer timer;
+    world.each([&count](auto) {
+        ++count;
+    });
+    timer.elapsed();
+
+    ASSERT_EQ(count, 10000u);
+}
+
+TEST(BenchmarkECXX, DestroyMany) {
+    world_t world;
+    std::vector<world_t::entity_type> entities(1000000);
+
+    std::cout << "Destroying 1000000 entities at once" << std::endl;
+
+    world.create<position, velocity>(entities.begin(), entities.end());
+
+    timer timer;
+    world.destroy(entities.begin(), entities.end());
+    timer.elapsed();
+}
+
+TEST(BenchmarkECXX, DestroyManyOneByOne) {
+    world_t world;
+    std::vector<world_t::entity_type> entities(1000000);
+
+    std::cout << "Destroying 1000000 entities one by one" << std::endl;
+
+    world.create<position, velocity>(entities.begin(), entities.end());
+
+    timer timer;
+    for (const auto entity : entities) {
+        world.destroy(entity);
+    }
+    timer.elapsed();
+}
+
+template<std::size_t ...N>
+void register_components(world_t& world, std::index_sequence<N...>) {
+    auto e = world.create<comp<N>...>();
+    world.destroy(e);
+}
+
+TEST(BenchmarkECXX, DestroyManyTypesOneByOne) {
+    world_t world;
+    std::vector<world_t::entity_type> entities(1000000);
+
+    std::cout << "Destroying 1000000 entities with 2 of 200 component types one by one" << std::endl;
+
+    register_components(world, std::make_index_sequence<200>{});
+    world.create<position, velocity>(entities.begin(), entities.end());
+
+    timer timer;
+    for (const auto entity : entities) {
+        world.destroy(entity);
+    }
+    timer.elapsed();
+}
+
+template<typename Component>
+void remove_scattered(const char* name) {
+    world_t world;
+    std::vector<world_t::entity_type> entities(1000000);
+    world.create<Component>(entities.begin(), entities.end());
+    std::shuffle(entities.begin(), entities.end(), std::minstd_rand{});
+
+    timer timer;
+    for (auto it = entities.begin(); it != entities.begin() + 500000; ++it) {
+        world.template remove<Component>(*it);
+    }
+    world.template pack<Component>();
+    std::cout << name;
+    timer.elapsed();
+
+    std::size_t count = 0u;
+    for (auto e : world.template view<Component>()) {
+        count += e != nullptr ? 1u : 0u;
+    }
+    ASSERT_EQ(count, 500000u);
+}
+
+TEST(BenchmarkECXX, RemoveScattered) {
+    std::cout << "Removing 500000 random components of 1000000 one by one" << std::endl;
+
+    remove_scattered<position>("Swap and pop: ");
+    remove_scattered<stable_position>("Tombstones and pack: ");
+}
+
+template<std::size_t N>
+void rolling_wave(world_t& world, std::vector<world_t::entity_type>& entities) {
+    // spawn wave tagged by N, keep first 1000 entities alive
+    world.create<comp<N>>(entities.begin(), entities.end());
+    world.destroy(entities.begin() + 1000, entities.end());
+    std::cout << "RSS: " << resident_memory_kb() << " KB, cached sparse pages: "
+              << world.page_pool().free_pages() << std::endl;
+}
+
+TEST(BenchmarkECXX, ChurnMemory) {
+    world_t world;
+    std::vector<world_t::entity_type> entities(200000);
+
+    std::cout << "Rolling waves of 200000 entities with 8 component types, steady-state memory" << std::endl;
+
+    timer timer;
+    for (auto i = 0; i < 4; ++i) {
+        rolling_wave<0>(world, entities);
+        rolling_wave<1>(world, entities);
+        rolling_wave<2>(world, entities);
+        rolling_wave<3>(world, entities);
+        rolling_wave<4>(world, entities);
+        rolling_wave<5>(world, entities);
+        rolling_wave<6>(world, entities);
+        rolling_wave<7>(world, entities);
+    }
+    timer.elapsed();
+}
+
 TEST(BenchmarkECXX, IterateSingleComponent1M) {
     world_t world;
 
@@ -213,6 +604,85 @@ TEST(BenchmarkECXX, IterateTwoComponents1M) {
     });
 }
 
+TEST(BenchmarkECXX, IterateTwoComponents1MExclude) {
+    world_t registry;
+
+    std::cout << "Iterating over 1000000 entities, two components, 1 of 10 is excluded" << std::endl;
+
+    for (std::uint64_t i = 0; i < 1000000L; i++) {
+        const auto entity = registry.create();
+        registry.assign<position>(entity);
+        registry.assign<velocity>(entity);
+        if (i % 10 == 0u) {
+            registry.assign<comp<0>>(entity);
+        }
+    }
+
+    {
+        std::cout << "has() in loop: ";
+        timer timer;
+        for (auto e : registry.view<position, velocity>()) {
+            if (!registry.has<comp<0>>(e)) {
+                registry.get<position>(e).x = {};
+                registry.get<velocity>(e).x = {};
+            }
+        }
+        timer.elapsed();
+    }
+
+    {
+        std::cout << "exclude: ";
+        timer timer;
+        registry.view<position, velocity>(exclude<comp<0>>).each([](auto& ... comp) {
+            ((comp.x = {}), ...);
+        });
+        timer.elapsed();
+    }
+}
+
+TEST(BenchmarkECXX, IntegrateAoSvsSoA) {
+    std::vector<world_t::entity_type> entities(1000000);
+    const float dt = 0.016f;
+
+    std::cout << "Integrating positions of 1000000 entities, 10 times" << std::endl;
+
+    {
+        world_t registry;
+        registry.create<float_position, float_velocity>(entities.begin(), entities.end());
+        std::cout << "AoS view: ";
+        timer timer;
+        for (int i = 0; i < 10; ++i) {
+            registry.view<float_position, float_velocity>().each([dt](auto& pos, const auto& vel) {
+                pos.x += vel.x * dt;
+                pos.y += vel.y * dt;
+            });
+        }
+        timer.elapsed();
+    }
+
+    {
+        world_t registry;
+        registry.create<soa_position, soa_velocity>(entities.begin(), entities.end());
+        std::cout << "SoA spans: ";
+        timer timer;
+        for (int i = 0; i < 10; ++i) {
+            auto x = registry.span<&soa_position::x>();
+            auto y = registry.span<&soa_position::y>();
+            auto vx = registry.span<&soa_velocity::x>();
+            auto vy = registry.span<&soa_velocity::y>();
+            float* __restrict px = x.data();
+            float* __restrict py = y.data();
+            const float* __restrict pvx = vx.data();
+            const float* __restrict pvy = vy.data();
+            for (std::size_t j = 0u, n = x.size(); j != n; ++j) {
+                px[j] += pvx[j] * dt;
+                py[j] += pvy[j] * dt;
+            }
+        }
+        timer.elapsed();
+    }
+}
+
 TEST(BenchmarkECXX, IterateTwoComponents1MHalf) {
     world_t registry;
 
@@ -678,6 +1148,92 @@ TEST(BenchmarkECXX, IterateFiveComponents1M) {
     });
 }
 
+template<typename World>
+void static_vs_dynamic(const char* name) {
+    World world;
+    std::vector<typename World::entity_type> entities(1000000);
+    world.create(entities.begin(), entities.end());
+
+    std::cout << name << std::endl;
+    {
+        std::cout << "assign: ";
+        timer timer;
+        for (auto e : entities) {
+            world.template assign<position>(e);
+            world.template assign<velocity>(e);
+            world.template assign<comp<0>>(e);
+            world.template assign<comp<1>>(e);
+            world.template assign<comp<2>>(e);
+        }
+        timer.elapsed();
+    }
+    {
+        std::cout << "iterate: ";
+        timer timer;
+        world.template view<position, velocity, comp<0>, comp<1>, comp<2>>().each([](auto& ... comp) {
+            ((comp.x = {}), ...);
+        });
+        timer.elapsed();
+    }
+    {
+        std::cout << "destroy: ";
+        timer timer;
+        for (auto e : entities) {
+            world.destroy(e);
+        }
+        timer.elapsed();
+    }
+}
+
+TEST(BenchmarkECXX, StaticWorld) {
+    std::cout << "1000000 entities, five components" << std::endl;
+
+    static_vs_dynamic<world_t>("Dynamic world:");
+    static_vs_dynamic<static_world<position, velocity, comp<0>, comp<1>, comp<2>>>("Static world:");
+}
+
+template<typename World, typename ...Component>
+void iterate_backend(const char* name, bool half) {
+    World world;
+    for (std::uint64_t i = 0; i < 1000000L; i++) {
+        const auto entity = world.create();
+        (world.template assign<Component>(entity), ...);
+        if (half && i % 2) {
+            world.template assign<comp<7>>(entity);
+        }
+    }
+
+    std::cout << name;
+    timer timer;
+    if (half) {
+        world.template view<comp<7>, Component...>().each([](auto& ... comp) {
+            ((comp.x = {}), ...);
+        });
+    } else {
+        world.template view<Component...>().each([](auto& ... comp) {
+            ((comp.x = {}), ...);
+        });
+    }
+    timer.elapsed();
+}
+
+template<typename ...Component>
+void iterate_backends(const char* name) {
+    std::cout << "Iterating over 1000000 entities, " << name << std::endl;
+    iterate_backend<world_t, Component...>("Sparse sets: ", false);
+    iterate_backend<archetype_world_t, Component...>("Archetypes: ", false);
+    std::cout << "Half of the entities have all the components" << std::endl;
+    iterate_backend<world_t, Component...>("Sparse sets: ", true);
+    iterate_backend<archetype_world_t, Component...>("Archetypes: ", true);
+}
+
+TEST(BenchmarkECXX, IterateBackends) {
+    iterate_backends<position>("one component");
+    iterate_backends<position, velocity>("two components");
+    iterate_backends<position, velocity, comp<0>>("three components");
+    iterate_backends<position, velocity, comp<0>, comp<1>, comp<2>>("five components");
+}
+
 TEST(BenchmarkECXX, IterateFiveComponents1MHalf) {
     world_t registry;
 
@@ -968,6 +1524,16 @@ TEST(BenchmarkECXX, IteratePathological) {
     });
 }
 
+TEST(BenchmarkECXX, IteratePathologicalBulkDestroy) {
+    std::cout << "Pathological case (bulk destroy)" << std::endl;
+
+    pathological<true>([](auto &registry, auto func) {
+        timer timer;
+        registry.template view<position, velocity, comp<0>>().each(func);
+        timer.elapsed();
+    });
+}
+
 //TEST(BenchmarkECXX, IteratePathologicalNonOwningGroup) {
 //    std::cout << "Pathological case (non-owning group)" << std::endl;
 //
@@ -1004,103 +1570,134 @@ TEST(BenchmarkECXX, IteratePathological) {
 //    });
 //}
 
-//TEST(BenchmarkECXX, SortSingle) {
-//    world_t registry;
-//
-//    std::cout << "Sort 150000 entities, one component" << std::endl;
-//
-//    for(std::uint64_t i = 0; i < 150000L; i++) {
-//        const auto entity = registry.create();
-//        registry.assign<position>(entity, i, i);
-//    }
-//
-//    timer timer;
-//
-//    registry.sort<position>([](const auto &lhs, const auto &rhs) {
-//        return lhs.x < rhs.x && lhs.y < rhs.y;
-//    });
-//
-//    timer.elapsed();
-//}
+TEST(BenchmarkECXX, SortSingle) {
+    world_t registry;
 
-//TEST(BenchmarkECXX, SortMulti) {
-//    world_t registry;
-//
-//    std::cout << "Sort 150000 entities, two components" << std::endl;
-//
-//    for(std::uint64_t i = 0; i < 150000L; i++) {
-//        const auto entity = registry.create();
-//        registry.assign<position>(entity, i, i);
-//        registry.assign<velocity>(entity, i, i);
-//    }
-//
-//    registry.sort<position>([](const auto &lhs, const auto &rhs) {
-//        return lhs.x < rhs.x && lhs.y < rhs.y;
-//    });
-//
-//    timer timer;
-//
-//    registry.sort<velocity, position>();
-//
-//    timer.elapsed();
-//}
+    std::cout << "Sort 150000 entities, one component" << std::endl;
 
-//TEST(BenchmarkECXX, AlmostSortedStdSort) {
-//    world_t registry;
-//    entt::entity entities[3];
-//
-//    std::cout << "Sort 150000 entities, almost sorted, std::sort" << std::endl;
-//
-//    for(std::uint64_t i = 0; i < 150000L; i++) {
-//        const auto entity = registry.create();
-//        registry.assign<position>(entity, i, i);
-//
-//        if(!(i % 50000)) {
-//            entities[i / 50000] = entity;
-//        }
-//    }
-//
-//    for(std::uint64_t i = 0; i < 3; ++i) {
-//        registry.destroy(entities[i]);
-//        const auto entity = registry.create();
-//        registry.assign<position>(entity, 50000 * i, 50000 * i);
-//    }
-//
-//    timer timer;
-//
-//    registry.sort<position>([](const auto &lhs, const auto &rhs) {
-//        return lhs.x > rhs.x && lhs.y > rhs.y;
-//    });
-//
-//    timer.elapsed();
-//}
+    for(std::uint64_t i = 0; i < 150000L; i++) {
+        const auto entity = registry.create();
+        registry.assign<position>(entity, i, i);
+    }
 
-//TEST(BenchmarkECXX, AlmostSortedInsertionSort) {
-//    world_t registry;
-//    entt::entity entities[3];
-//
-//    std::cout << "Sort 150000 entities, almost sorted, insertion sort" << std::endl;
-//
-//    for(std::uint64_t i = 0; i < 150000L; i++) {
-//        const auto entity = registry.create();
-//        registry.assign<position>(entity, i, i);
-//
-//        if(!(i % 50000)) {
-//            entities[i / 50000] = entity;
-//        }
-//    }
-//
-//    for(std::uint64_t i = 0; i < 3; ++i) {
-//        registry.destroy(entities[i]);
-//        const auto entity = registry.create();
-//        registry.assign<position>(entity, 50000 * i, 50000 * i);
-//    }
-//
-//    timer timer;
-//
-//    registry.sort<position>([](const auto &lhs, const auto &rhs) {
-//        return lhs.x > rhs.x && lhs.y > rhs.y;
-//    }, entt::insertion_sort{});
-//
-//    timer.elapsed();
-//}
\ No newline at end of file
+    timer timer;
+
+    registry.sort<position>([](const auto &lhs, const auto &rhs) {
+        return lhs.x < rhs.x && lhs.y < rhs.y;
+    });
+
+    timer.elapsed();
+}
+
+TEST(BenchmarkECXX, SortMulti) {
+    world_t registry;
+
+    std::cout << "Sort 150000 entities, two components" << std::endl;
+
+    for(std::uint64_t i = 0; i < 150000L; i++) {
+        const auto entity = registry.create();
+        registry.assign<position>(entity, i, i);
+        registry.assign<velocity>(entity, i, i);
+    }
+
+    registry.sort<position>([](const auto &lhs, const auto &rhs) {
+        return lhs.x < rhs.x && lhs.y < rhs.y;
+    });
+
+    timer timer;
+
+    registry.respect<velocity, position>();
+
+    timer.elapsed();
+}
+
+TEST(BenchmarkECXX, IterateTwoComponents1MRespect) {
+    world_t registry;
+    std::vector<world_t::entity_type> entities(1000000);
+    registry.create<position>(entities.begin(), entities.end());
+
+    std::cout << "Iterating over 1000000 entities, two components, shuffled second pool" << std::endl;
+
+    std::shuffle(entities.begin(), entities.end(), std::minstd_rand{});
+    for (auto e : entities) {
+        registry.assign<velocity>(e);
+    }
+
+    auto test = [&registry](auto func) {
+        timer timer;
+        registry.view<position, velocity>().each(func);
+        timer.elapsed();
+    };
+
+    std::cout << "Shuffled: ";
+    test([](auto& ... comp) {
+        ((comp.x = {}), ...);
+    });
+
+    registry.respect<velocity, position>();
+
+    std::cout << "Respect: ";
+    test([](auto& ... comp) {
+        ((comp.x = {}), ...);
+    });
+}
+
+TEST(BenchmarkECXX, AlmostSortedStdSort) {
+    world_t registry;
+    world_t::entity_type entities[3];
+
+    std::cout << "Sort 150000 entities, almost sorted, std::sort" << std::endl;
+
+    for(std::uint64_t i = 0; i < 150000L; i++) {
+        const auto entity = registry.create();
+        registry.assign<position>(entity, i, i);
+
+        if(!(i % 50000)) {
+            entities[i / 50000] = entity;
+        }
+    }
+
+    for(std::uint64_t i = 0; i < 3; ++i) {
+        registry.destroy(entities[i]);
+        const auto entity = registry.create();
+        registry.assign<position>(entity, 50000 * i, 50000 * i);
+    }
+
+    timer timer;
+
+    registry.sort<position>([](const auto &lhs, const auto &rhs) {
+        return lhs.x < rhs.x && lhs.y < rhs.y;
+    });
+
+    timer.elapsed();
+}
+
+TEST(BenchmarkECXX, AlmostSortedInsertionSort) {
+    world_t registry;
+    world_t::entity_type entities[3];
+
+    std::cout << "Sort 150000 entities, almost sorted, insertion sort" << std::endl;
+
+    for(std::uint64_t i = 0; i < 150000L; i++) {
+        const auto entity = registry.create();
+        registry.assign<position>(entity, i, i);
+
+        if(!(i % 50000)) {
+            entities[i / 50000] = entity;
+        }
+    }
+
+    for(std::uint64_t i = 0; i < 3; ++i) {
+        registry.destroy(entities[i]);
+        const auto entity = registry.create();
+        registry.assign<position>(entity, 50000 * i, 50000 * i);
+    }
+
+    timer timer;
+
+    registry.sort<position>([](const auto &lhs, const auto &rhs) {
+        return lhs.x < rhs.x && lhs.y < rhs.y;
+    }, insertion_sort{});
+
+    timer.elapsed();
+}
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "impl/world.h"
+#include "impl/static_world.h"
+#include "impl/archetype_world.h"
 #include "impl/entity_wrapper_impl.h"
+#include "impl/memory_resource.h"
 
 namespace ecxx {
 
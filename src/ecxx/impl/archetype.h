@@ -0,0 +1,254 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+#include <vector>
+#include <memory_resource>
+#include "entity_value.h"
+#include "identity_generator.h"
+
+namespace ecxx {
+
+// type-erased operations on component values stored in archetype columns
+struct component_info {
+    uint32_t type;
+    uint32_t size;
+    uint32_t alignment;
+    // move value to uninitialized `to`, `from` is destroyed
+    void (* relocate)(void* to, void* from);
+    void (* destroy)(void* value);
+};
+
+template<typename Component>
+inline const component_info* component_info_of() {
+    static_assert(std::is_move_constructible_v<Component>, "archetype component must be move-constructible");
+    static_assert(alignof(Component) <= 64u, "archetype component alignment is too large");
+    static const component_info info{
+            identity_generator<Component, uint32_t>::value,
+            static_cast<uint32_t>(sizeof(Component)),
+            static_cast<uint32_t>(alignof(Component)),
+            [](void* to, void* from) {
+                auto* value = static_cast<Component*>(from);
+                new(to) Component(std::move(*value));
+                value->~Component();
+            },
+            [](void* value) {
+                static_cast<Component*>(value)->~Component();
+            }
+    };
+    return &info;
+}
+
+/**
+ * table of entities with the same set of components:
+ * rows are packed into fixed-size chunks, every chunk has entity column and column per component,
+ * so iteration over any subset of components is linear.
+ * All chunks are full except the last one, removed row is filled by the last row
+ **/
+template<typename EntityType>
+class archetype {
+public:
+    using entity_type = entity_value<EntityType>;
+    using components_type = std::pmr::vector<const component_info*>;
+
+    static constexpr uint32_t npos = ~0u;
+    static constexpr size_t chunk_alignment = 64u;
+
+    // cached transitions to archetypes with single component added or removed
+    struct edge {
+        uint32_t type;
+        uint32_t add;
+        uint32_t remove;
+    };
+
+    /**
+     * components - required to be sorted by type
+     * chunk_size - bytes per chunk, single row is always stored even if it's larger
+     **/
+    archetype(const components_type& components, uint32_t chunk_size, std::pmr::memory_resource* resource)
+            : components_{components, resource},
+              offsets_{resource},
+              column_of_{resource},
+              chunks_{resource},
+              edges_{resource} {
+        assert(std::is_sorted(components_.begin(), components_.end(), [](auto* a, auto* b) {
+            return a->type < b->type;
+        }));
+
+        size_t row_size = sizeof(entity_type);
+        for (auto* info : components_) {
+            row_size += info->size;
+        }
+        capacity_ = std::max<uint32_t>(1u, static_cast<uint32_t>(chunk_size / row_size));
+        // alignment padding could overflow chunk
+        while (capacity_ > 1u && layout(capacity_) > chunk_size) {
+            --capacity_;
+        }
+        chunk_size_ = std::max<size_t>(chunk_size, layout(capacity_));
+
+        offsets_.resize(components_.size());
+        size_t offset = sizeof(entity_type) * capacity_;
+        for (size_t i = 0u; i != components_.size(); ++i) {
+            offset = align(offset, components_[i]->alignment);
+            offsets_[i] = offset;
+            offset += size_t{components_[i]->size} * capacity_;
+        }
+
+        if (!components_.empty()) {
+            column_of_.resize(components_.back()->type + 1u, npos);
+            for (uint32_t i = 0u; i != components_.size(); ++i) {
+                column_of_[components_[i]->type] = i;
+            }
+        }
+    }
+
+    archetype(const archetype&) = delete;
+
+    archetype& operator=(const archetype&) = delete;
+
+    ~archetype() {
+        for (uint32_t row = 0u; row != size_; ++row) {
+            for (uint32_t column = 0u; column != components_.size(); ++column) {
+                components_[column]->destroy(at(row, column));
+            }
+        }
+        for (auto* chunk : chunks_) {
+            resource()->deallocate(chunk, chunk_size_, chunk_alignment);
+        }
+    }
+
+    inline bool has(uint32_t type) const {
+        return type < column_of_.size() && column_of_[type] != npos;
+    }
+
+    inline uint32_t column(uint32_t type) const {
+        return type < column_of_.size() ? column_of_[type] : npos;
+    }
+
+    inline const components_type& components() const {
+        return components_;
+    }
+
+    // number of rows
+    inline uint32_t size() const {
+        return size_;
+    }
+
+    // rows per chunk
+    inline uint32_t chunk_capacity() const {
+        return capacity_;
+    }
+
+    // chunks containing rows
+    inline uint32_t chunks_num() const {
+        return (size_ + capacity_ - 1u) / capacity_;
+    }
+
+    inline uint32_t chunk_rows(uint32_t chunk) const {
+        return std::min(capacity_, size_ - chunk * capacity_);
+    }
+
+    inline entity_type* entities(uint32_t chunk) const {
+        return reinterpret_cast<entity_type*>(chunks_[chunk]);
+    }
+
+    template<typename Component>
+    inline Component* data(uint32_t chunk, uint32_t column) const {
+        return reinterpret_cast<Component*>(chunks_[chunk] + offsets_[column]);
+    }
+
+    inline entity_type entity_at(uint32_t row) const {
+        return entities(row / capacity_)[row % capacity_];
+    }
+
+    inline void* at(uint32_t row, uint32_t column) const {
+        return chunks_[row / capacity_] + offsets_[column] + size_t{components_[column]->size} * (row % capacity_);
+    }
+
+    // append row for `e`, component values are left uninitialized
+    uint32_t emplace(entity_type e) {
+        if (size_ == chunks_.size() * capacity_) {
+            chunks_.push_back(static_cast<uint8_t*>(resource()->allocate(chunk_size_, chunk_alignment)));
+        }
+        const uint32_t row = size_++;
+        new(entities(row / capacity_) + row % capacity_) entity_type{e};
+        return row;
+    }
+
+    void reserve(uint32_t rows) {
+        while (chunks_.size() * capacity_ < rows) {
+            chunks_.push_back(static_cast<uint8_t*>(resource()->allocate(chunk_size_, chunk_alignment)));
+        }
+    }
+
+    /**
+     * remove row with already destroyed or relocated component values,
+     * returns entity moved from the last row to `row`, or null
+     **/
+    entity_type remove(uint32_t row) {
+        assert(row < size_);
+        const uint32_t last = --size_;
+        if (row == last) {
+            return entity_type::null;
+        }
+        const entity_type moved = entity_at(last);
+        entities(row / capacity_)[row % capacity_] = moved;
+        for (uint32_t column = 0u; column != components_.size(); ++column) {
+            components_[column]->relocate(at(row, column), at(last, column));
+        }
+        return moved;
+    }
+
+    // destroy component values of row and remove it, see `remove`
+    entity_type destroy(uint32_t row) {
+        for (uint32_t column = 0u; column != components_.size(); ++column) {
+            components_[column]->destroy(at(row, column));
+        }
+        return remove(row);
+    }
+
+    inline edge& edge_for(uint32_t type) {
+        for (auto& e : edges_) {
+            if (e.type == type) {
+                return e;
+            }
+        }
+        return edges_.emplace_back(edge{type, npos, npos});
+    }
+
+    inline std::pmr::memory_resource* resource() const {
+        return chunks_.get_allocator().resource();
+    }
+
+private:
+
+    static inline size_t align(size_t offset, size_t alignment) {
+        return (offset + alignment - 1u) & ~(alignment - 1u);
+    }
+
+    size_t layout(uint32_t capacity) const {
+        size_t offset = sizeof(entity_type) * capacity;
+        for (auto* info : components_) {
+            offset = align(offset, info->alignment) + size_t{info->size} * capacity;
+        }
+        return offset;
+    }
+
+    components_type components_;
+    // byte offset of component column in chunk
+    std::pmr::vector<size_t> offsets_;
+    // component type -> column
+    std::pmr::vector<uint32_t> column_of_;
+    std::pmr::vector<uint8_t*> chunks_;
+    std::pmr::vector<edge> edges_;
+    size_t chunk_size_ = 0u;
+    uint32_t capacity_ = 1u;
+    uint32_t size_ = 0u;
+};
+
+}
@@ -0,0 +1,393 @@
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <new>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <memory_resource>
+#include "entity_pool.h"
+#include "archetype.h"
+
+namespace ecxx {
+
+/**
+ * view over archetypes containing all `Component`,
+ * `each` walks matching chunks linearly without sparse lookups.
+ * Components could not be added or removed during iteration
+ **/
+template<typename EntityType, typename ...Component>
+class archetype_view {
+public:
+    using entity_type = entity_value<EntityType>;
+    using archetype_type = archetype<EntityType>;
+    using archetypes_type = std::pmr::vector<archetype_type*>;
+
+    static constexpr auto components_num = sizeof ... (Component);
+
+    explicit archetype_view(const archetypes_type& archetypes)
+            : archetypes_{archetypes} {
+    }
+
+    /**
+     * func(Component&...) or func(entity_type, Component&...),
+     * order is archetype by archetype, chunk by chunk
+     **/
+    template<typename Func>
+    void each(Func func) const {
+        for (auto* table : archetypes_) {
+            if (table->size() != 0u && (table->has(type<Component>()) && ...)) {
+                each(*table, func, std::index_sequence_for<Component...>{});
+            }
+        }
+    }
+
+    // number of entities in view
+    size_t size() const {
+        size_t count = 0u;
+        for (auto* table : archetypes_) {
+            if ((table->has(type<Component>()) && ...)) {
+                count += table->size();
+            }
+        }
+        return count;
+    }
+
+private:
+
+    template<typename Comp>
+    static inline uint32_t type() {
+        return identity_generator<Comp, uint32_t>::value;
+    }
+
+    template<typename Func, size_t ...I>
+    static inline void each(const archetype_type& table, Func& func, std::index_sequence<I...>) {
+        const std::array<uint32_t, components_num> columns{table.column(type<Component>())...};
+        const uint32_t chunks = table.chunks_num();
+        for (uint32_t chunk = 0u; chunk != chunks; ++chunk) {
+            const uint32_t rows = table.chunk_rows(chunk);
+            const std::tuple<Component* ...> data{table.template data<Component>(chunk, columns[I])...};
+            if constexpr (std::is_invocable_v<Func&, entity_type, Component& ...>) {
+                const entity_type* entities = table.entities(chunk);
+                for (uint32_t row = 0u; row != rows; ++row) {
+                    func(entities[row], std::get<I>(data)[row]...);
+                }
+            } else {
+                for (uint32_t row = 0u; row != rows; ++row) {
+                    func(std::get<I>(data)[row]...);
+                }
+            }
+        }
+    }
+
+    const archetypes_type& archetypes_;
+};
+
+/**
+ * world with archetype storage backend: entities with the same set of components
+ * are stored together in chunked tables, see `archetype`.
+ * Multi-component iteration is linear, adding and removing component moves entity between tables.
+ * Subset of `base_world` API: no signals, change tracking, sorting or SoA layouts
+ **/
+template<typename EntityType>
+class basic_archetype_world {
+public:
+    using entity_type = entity_value<EntityType>;
+    using entity_pool = basic_entity_pool<EntityType>;
+    using component_typeid = uint32_t;
+    using archetype_type = archetype<EntityType>;
+
+    static constexpr uint32_t default_chunk_size = 0x4000u;
+
+    explicit basic_archetype_world(std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+                                   uint32_t chunk_size = default_chunk_size)
+            : pool_{resource},
+              archetypes_{resource},
+              locations_{resource},
+              chunk_size_{chunk_size} {
+        // root archetype without components, entities are never stored in it
+        create_archetype(typename archetype_type::components_type{resource});
+    }
+
+    basic_archetype_world(const basic_archetype_world&) = delete;
+
+    basic_archetype_world& operator=(const basic_archetype_world&) = delete;
+
+    ~basic_archetype_world() {
+        std::pmr::polymorphic_allocator<archetype_type> allocator{resource()};
+        for (auto* table : archetypes_) {
+            table->~archetype_type();
+            allocator.deallocate(table, 1u);
+        }
+    }
+
+    inline void reserve(size_t size) {
+        pool_.reserve(size);
+        locations_.reserve(size + 1u);
+    }
+
+    template<typename ...Component>
+    inline entity_type create() {
+        const auto e = pool_.allocate();
+        if constexpr (sizeof...(Component) != 0u) {
+            const uint32_t index = find_archetype<Component...>();
+            auto& table = *archetypes_[index];
+            const uint32_t row = table.emplace(e);
+            (new(component_at<Component>(table, row)) Component{}, ...);
+            location_of(e) = {index, row};
+        }
+        return e;
+    }
+
+    template<typename ...Component, typename It>
+    void create(It begin, It end) {
+        pool_.allocate(begin, end);
+        if constexpr (sizeof...(Component) != 0u) {
+            const uint32_t index = find_archetype<Component...>();
+            auto& table = *archetypes_[index];
+            table.reserve(table.size() + static_cast<uint32_t>(std::distance(begin, end)));
+            for (auto it = begin; it != end; ++it) {
+                const uint32_t row = table.emplace(*it);
+                (new(component_at<Component>(table, row)) Component{}, ...);
+                location_of(*it) = {index, row};
+            }
+        }
+    }
+
+    void destroy(entity_type entity) {
+        auto& location = location_of(entity);
+        if (location.archetype != 0u) {
+            moved(archetypes_[location.archetype]->destroy(location.row), location.row);
+            location = {};
+        }
+        pool_.deallocate(entity);
+    }
+
+    // deliberately unbatched: single destroy is already O(components of entity) swap with the last row,
+    // grouping entities by archetype would only add sort of their rows
+    template<typename It>
+    void destroy(It begin, It end) {
+        for (auto it = begin; it != end; ++it) {
+            destroy(*it);
+        }
+    }
+
+    template<typename Func>
+    inline void each(Func func) const {
+        pool_.each(func);
+    }
+
+    // entity is moved to archetype with `Component` added
+    template<typename Component, typename ...Args>
+    Component& assign(entity_type entity, Args&& ... args) {
+        assert(!has<Component>(entity));
+        auto& location = location_of(entity);
+        const uint32_t to = add_edge(location.archetype, component_info_of<Component>());
+        auto& table = *archetypes_[to];
+        const uint32_t row = table.emplace(entity);
+        // constructed before move, so `args` could refer to other components of entity
+        Component* component;
+        if constexpr (std::is_aggregate_v<Component>) {
+            component = new(component_at<Component>(table, row)) Component{std::forward<Args>(args)...};
+        } else {
+            component = new(component_at<Component>(table, row)) Component(std::forward<Args>(args)...);
+        }
+        transfer(location, to, row);
+        return *component;
+    }
+
+    template<typename Component, typename ...Args>
+    Component& replace_or_assign(entity_type entity, Args&& ... args) {
+        if (has<Component>(entity)) {
+            auto& component = get<Component>(entity);
+            if constexpr (std::is_aggregate_v<Component>) {
+                component = Component{std::forward<Args>(args)...};
+            } else {
+                component = Component(std::forward<Args>(args)...);
+            }
+            return component;
+        }
+        return assign<Component>(entity, std::forward<Args>(args)...);
+    }
+
+    // entity is moved to archetype with `Component` removed
+    template<typename Component>
+    void remove(entity_type entity) {
+        assert(has<Component>(entity));
+        auto& location = location_of(entity);
+        const uint32_t to = remove_edge(location.archetype, component_info_of<Component>());
+        if (to != 0u) {
+            transfer(location, to, archetypes_[to]->emplace(entity));
+        } else {
+            moved(archetypes_[location.archetype]->destroy(location.row), location.row);
+            location = {};
+        }
+    }
+
+    template<typename Component>
+    inline bool has(entity_type entity) const {
+        const auto index = entity.index();
+        return index < locations_.size() && archetypes_[locations_[index].archetype]->has(type<Component>());
+    }
+
+    template<typename Component>
+    inline Component& get(entity_type entity) {
+        assert(has<Component>(entity));
+        const auto& location = locations_[entity.index()];
+        return *component_at<Component>(*archetypes_[location.archetype], location.row);
+    }
+
+    template<typename Component>
+    inline const Component& get(entity_type entity) const {
+        assert(has<Component>(entity));
+        const auto& location = locations_[entity.index()];
+        return *component_at<Component>(*archetypes_[location.archetype], location.row);
+    }
+
+    template<typename ...Component>
+    inline auto view() const {
+        return archetype_view<EntityType, Component...>{archetypes_};
+    }
+
+    inline const auto& archetypes() const {
+        return archetypes_;
+    }
+
+    inline const auto& pool() const {
+        return pool_;
+    }
+
+    inline auto& pool() {
+        return pool_;
+    }
+
+    template<typename Component>
+    inline component_typeid type() const noexcept {
+        return identity_generator<Component, component_typeid>::value;
+    }
+
+    inline bool valid(entity_type entity) const {
+        return pool_.valid(entity);
+    }
+
+    template<typename It, typename Out>
+    inline Out valid(It begin, It end, Out out) const {
+        return pool_.valid(begin, end, out);
+    }
+
+    inline std::pmr::memory_resource* resource() const {
+        return archetypes_.get_allocator().resource();
+    }
+
+private:
+
+    // archetype 0 means entity has no components
+    struct slot {
+        uint32_t archetype = 0u;
+        uint32_t row = 0u;
+    };
+
+    template<typename Component>
+    static inline Component* component_at(const archetype_type& table, uint32_t row) {
+        return static_cast<Component*>(table.at(row, table.column(identity_generator<Component, uint32_t>::value)));
+    }
+
+    inline slot& location_of(entity_type entity) {
+        const auto index = entity.index();
+        if (index >= locations_.size()) {
+            locations_.resize(index + 1u);
+        }
+        return locations_[index];
+    }
+
+    // entity of the last row is moved to `row`
+    inline void moved(entity_type entity, uint32_t row) {
+        if (entity != nullptr) {
+            locations_[entity.index()].row = row;
+        }
+    }
+
+    // move components of entity to reserved `row` of archetype `to`, values missing in `to` are destroyed
+    void transfer(slot& from, uint32_t to, uint32_t row) {
+        if (from.archetype != 0u) {
+            auto& source = *archetypes_[from.archetype];
+            auto& target = *archetypes_[to];
+            const auto& components = source.components();
+            for (uint32_t column = 0u; column != components.size(); ++column) {
+                const uint32_t target_column = target.column(components[column]->type);
+                if (target_column != archetype_type::npos) {
+                    components[column]->relocate(target.at(row, target_column), source.at(from.row, column));
+                } else {
+                    components[column]->destroy(source.at(from.row, column));
+                }
+            }
+            moved(source.remove(from.row), from.row);
+        }
+        from = {to, row};
+    }
+
+    template<typename ...Component>
+    uint32_t find_archetype() {
+        uint32_t index = 0u;
+        ((index = add_edge(index, component_info_of<Component>())), ...);
+        return index;
+    }
+
+    uint32_t add_edge(uint32_t from, const component_info* info) {
+        auto& edge = archetypes_[from]->edge_for(info->type);
+        if (edge.add == archetype_type::npos) {
+            typename archetype_type::components_type components{archetypes_[from]->components(), resource()};
+            components.insert(std::upper_bound(components.begin(), components.end(), info, [](auto* a, auto* b) {
+                return a->type < b->type;
+            }), info);
+            const uint32_t to = find_or_create(components);
+            edge.add = to;
+            archetypes_[to]->edge_for(info->type).remove = from;
+            return to;
+        }
+        return edge.add;
+    }
+
+    uint32_t remove_edge(uint32_t from, const component_info* info) {
+        auto& edge = archetypes_[from]->edge_for(info->type);
+        if (edge.remove == archetype_type::npos) {
+            typename archetype_type::components_type components{archetypes_[from]->components(), resource()};
+            components.erase(std::find(components.begin(), components.end(), info));
+            const uint32_t to = find_or_create(components);
+            edge.remove = to;
+            archetypes_[to]->edge_for(info->type).add = from;
+            return to;
+        }
+        return edge.remove;
+    }
+
+    uint32_t find_or_create(const typename archetype_type::components_type& components) {
+        for (uint32_t i = 0u; i != archetypes_.size(); ++i) {
+            if (archetypes_[i]->components() == components) {
+                return i;
+            }
+        }
+        return create_archetype(components);
+    }
+
+    uint32_t create_archetype(const typename archetype_type::components_type& components) {
+        std::pmr::polymorphic_allocator<archetype_type> allocator{resource()};
+        auto* table = allocator.allocate(1u);
+        new(table) archetype_type(components, chunk_size_, resource());
+        archetypes_.push_back(table);
+        return static_cast<uint32_t>(archetypes_.size() - 1u);
+    }
+
+    entity_pool pool_;
+    std::pmr::vector<archetype_type*> archetypes_;
+    // archetype and row by entity index
+    std::pmr::vector<slot> locations_;
+    uint32_t chunk_size_;
+};
+
+using archetype_world_t = basic_archetype_world<uint32_t>;
+
+}
@@ -1,9 +1,26 @@
 #pragma once
 
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 namespace ecxx {
 
 constexpr unsigned bit_count(const unsigned long long x) noexcept {
     return (x == 0u) ? 0u : ((x & 1u) + bit_count(x >> 1u));
 }
 
-}
\ No newline at end of file
+// x should be non-zero
+inline unsigned count_trailing_zeros(const uint64_t x) noexcept {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+}
+
+}
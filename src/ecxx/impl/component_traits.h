@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include "soa_vector.h"
+
+namespace ecxx {
+
+/**
+ * default storage settings for component pools,
+ * inherit it to override only required settings
+ **/
+struct default_component_traits {
+    // sparse table page size in bytes, power-of-two value
+    static constexpr uint32_t page_size = 0x8000u;
+
+    // number of elements reserved in dense arrays on pool creation
+    static constexpr uint32_t initial_capacity = 0u;
+
+    // dense arrays grow by `capacity * growth_percent / 100` (at least by one element) when full,
+    // 0 - default std::vector growth
+    static constexpr uint32_t growth_percent = 0u;
+
+    // number of components per storage chunk, power-of-two value:
+    // growth never moves components, references are stable until erase.
+    // 0 - single contiguous array
+    static constexpr uint32_t chunk_size = 0u;
+
+    // data members stored in separate aligned arrays (structure-of-arrays), all members must be listed,
+    // components are read by value and written by fields, empty list - plain array of components
+    using soa_layout = soa_fields<>;
+
+    // erase leaves tombstone in dense arrays instead of moving last element into the hole:
+    // order is preserved and erasing during iteration is safe,
+    // tombstones are counted by `size()` and skipped by views until `pack()`
+    static constexpr bool in_place_delete = false;
+
+    // stamp components with world tick when added or accessed for write
+    // (mutable `get`, SoA `field`, view callbacks taking non-const reference, replace),
+    // enables `changed_since` view filter
+    static constexpr bool track_changes = false;
+};
+
+/**
+ * customization point for component storage, for example:
+ *
+ * template<> struct ecxx::component_traits<rare_tag> : ecxx::default_component_traits {
+ *     static constexpr uint32_t page_size = 0x400u;
+ * };
+ **/
+template<typename Component>
+struct component_traits : default_component_traits {
+};
+
+}
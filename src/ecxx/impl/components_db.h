@@ -1,5 +1,7 @@
 #pragma once
 
+#include <new>
+#include <memory_resource>
 #include "entity_map.h"
 #include "identity_generator.h"
 
@@ -10,30 +12,68 @@ class components_db {
 public:
     using entity_type = entity_value<EntityType>;
     using component_typeid = uint32_t;
+    using component_hash = uint64_t;
 
     template<typename Component>
     using pool_type = entity_map<EntityType, Component>;
 
     using pool_base_type = entity_map_base<EntityType>;
 
+    using page_pool_type = typename pool_base_type::page_pool_type;
+    using tick_type = typename pool_base_type::tick_type;
+    using signatures_type = typename pool_base_type::signatures_type;
+
+    explicit components_db(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : page_pool_{resource},
+              signatures_{resource},
+              pools_{resource},
+              hashes_{resource} {
+    }
+
+    components_db(const components_db&) = delete;
+
+    components_db& operator=(const components_db&) = delete;
+
+    ~components_db() {
+        for (auto* pool : pools_) {
+            if (pool != nullptr) {
+                pool->destroy_dyn();
+            }
+        }
+    }
+
+    // dense index of pool, assigned on program start
     template<typename Component>
-    inline static constexpr component_typeid type() noexcept {
+    inline static component_typeid type() noexcept {
         return identity_generator<Component, component_typeid>::value;
     }
 
+    // compile-time key of pool, stable between processes
+    template<typename Component>
+    inline static constexpr component_hash hash() noexcept {
+        return type_hash<Component>();
+    }
+
     template<typename Component>
     pool_type<Component>& ensure() {
         const auto cid = type<Component>();
         if (cid < pools_.size()) {
         } else {
             pools_.resize(cid + 1u);
+            hashes_.resize(cid + 1u);
         }
 
         auto* map = pools_[cid];
         if (map != nullptr) {
         } else {
-            map = new pool_type<Component>();
+            std::pmr::polymorphic_allocator<pool_type<Component>> allocator{resource()};
+            auto* pool = allocator.allocate(1u);
+            map = new(pool) pool_type<Component>(&page_pool_, resource(), &tick_);
+            map->bind_signatures(&signatures_, cid);
+            // different types with the same name hash could not be found by hash
+            assert(find(hash<Component>()) == nullptr);
             pools_[cid] = map;
+            hashes_[cid] = hash<Component>();
         }
         return *static_cast<pool_type<Component>*>(map);
     }
@@ -56,16 +96,84 @@ public:
         return type < pools_.size() ? pools_[type] : nullptr;
     }
 
+    // pool of component with `hash`, for lookup by key from another process
+    pool_base_type* find(component_hash hash) const {
+        for (component_typeid type = 0u; type != pools_.size(); ++type) {
+            if (pools_[type] != nullptr && hashes_[type] == hash) {
+                return pools_[type];
+            }
+        }
+        return nullptr;
+    }
+
+    // visits only pools from entity signature
     void remove_all_c(entity_type entity) {
+        signatures_.each(entity.index(), [this, entity](component_typeid type) {
+            pools_[type]->erase_dyn(entity);
+        });
+    }
+
+    // pool-major order: each pool owning any entity of range processes the whole range with one virtual call
+    void remove_all_c(const entity_type* begin, const entity_type* end) {
+        const size_t stride = signatures_.stride();
+        std::pmr::vector<uint64_t> mask(stride, 0u, resource());
+        for (auto it = begin; it != end; ++it) {
+            const uint64_t* row = signatures_.row(it->index());
+            if (row != nullptr) {
+                for (size_t w = 0u; w != stride; ++w) {
+                    mask[w] |= row[w];
+                }
+            }
+        }
+        for (size_t w = 0u; w != stride; ++w) {
+            for (uint64_t word = mask[w]; word != 0u; word &= word - 1u) {
+                pools_[w * 64u + count_trailing_zeros(word)]->erase_dyn(begin, end);
+            }
+        }
+    }
+
+    // contained in pool of component `type`
+    inline bool owns(entity_type entity, component_typeid type) const {
+        return signatures_.test(entity.index(), type);
+    }
+
+    void remap(const std::vector<entity_type>& mapping) {
         for (auto* pool : pools_) {
-            if (pool != nullptr && pool->has(entity)) {
-                pool->erase_dyn(entity);
+            if (pool != nullptr) {
+                pool->remap(mapping);
             }
         }
+        signatures_.remap(mapping);
+    }
+
+    inline std::pmr::memory_resource* resource() const {
+        return pools_.get_allocator().resource();
+    }
+
+    // empty sparse pages of all pools are cached here
+    inline page_pool_type& page_pool() {
+        return page_pool_;
+    }
+
+    // current tick, components changed now are stamped with it
+    inline tick_type tick() const {
+        return tick_;
+    }
+
+    inline void advance_tick() {
+        ++tick_;
     }
 
 private:
-    std::vector<entity_map_base<EntityType>*> pools_;
+    // declared first to outlive pools
+    page_pool_type page_pool_;
+    // component bits per entity index, pools only write to it
+    signatures_type signatures_;
+    std::pmr::vector<entity_map_base<EntityType>*> pools_;
+    // `hash()` of component per pool
+    std::pmr::vector<component_hash> hashes_;
+    // starts after 0, so `changed_since(0)` reports all components
+    tick_type tick_ = 1u;
 };
 
 }
\ No newline at end of file
@@ -1,11 +1,20 @@
 #pragma once
 
 #include <vector>
+#include <cassert>
 #include <memory>
+#include <iterator>
 #include <type_traits>
+#include <memory_resource>
 #include "entity_spec.h"
 #include "entity_value.h"
 #include "sparse_vector.h"
+#include "sparse_vector_mmap.h"
+#include "component_traits.h"
+#include "paged_vector.h"
+#include "sort.h"
+#include "signal.h"
+#include "signature.h"
 
 namespace ecxx {
 
@@ -15,19 +24,48 @@ public:
 
     using entity_type = entity_value<EntityType>;
     using index_type = typename entity_type::index_type;
-    using entity_vector_type = std::vector<entity_type>;
-    using entity_vector_iterator = typename  std::vector<entity_type>::iterator;
-    using entity_vector_const_iterator = typename  std::vector<entity_type>::const_iterator;
-
-    entity_map_base() {
+    using entity_vector_type = std::pmr::vector<entity_type>;
+    using entity_vector_iterator = typename entity_vector_type::iterator;
+    using entity_vector_const_iterator = typename entity_vector_type::const_iterator;
+
+#ifdef ECXX_SPARSE_MMAP
+    using table_type = sparse_vector_mmap<index_type, entity_type::spec::index_cap, index_type>;
+#else
+    using table_type = sparse_vector<index_type, 0u, 0x8000u, index_type, entity_type::spec::index_cap>;
+#endif
+    using page_pool_type = typename table_type::page_pool_type;
+    using tick_type = uint32_t;
+    using signatures_type = entity_signatures<index_type>;
+
+    /**
+     * clock - current tick to stamp changed components with, see `component_traits::track_changes`,
+     * components are never stamped as changed if not provided
+     **/
+    explicit entity_map_base(page_pool_type* page_pool = nullptr,
+                             uint32_t page_size = default_component_traits::page_size,
+                             std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+                             const tick_type* clock = nullptr)
+            : table_{page_pool, page_size, resource},
+              entity_{resource},
+              ticks_{resource},
+              clock_{clock != nullptr ? clock : &stopped_clock},
+              on_construct_{resource},
+              on_destroy_{resource},
+              on_update_{resource} {
         entity_.emplace_back();
     }
 
     virtual ~entity_map_base() = default;
 
+    // destroy map allocated from its own memory resource
+    virtual void destroy_dyn() = 0;
+
     virtual void emplace_dyn(entity_type) = 0;
 
     virtual void erase_dyn(entity_type) = 0;
+
+    // erase all contained entities from range, skip the rest
+    virtual void erase_dyn(const entity_type* begin, const entity_type* end) = 0;
     //virtual void get()
 
     inline bool has(entity_type e) const {
@@ -50,7 +88,7 @@ public:
         return entity_.end();
     }
 
-    inline entity_type at(uint32_t index) const {
+    inline entity_type at(index_type index) const {
         return entity_[index];
     }
 
@@ -58,9 +96,86 @@ public:
         return static_cast<index_type>(entity_.size() - 1);
     }
 
+    inline size_t capacity() const {
+        return entity_.capacity() - 1u;
+    }
+
+    inline std::pmr::memory_resource* resource() const {
+        return entity_.get_allocator().resource();
+    }
+
+    inline bool tracks_changes() const {
+        return !ticks_.empty();
+    }
+
+    // emitted after component is added
+    inline signal<entity_type>& on_construct() {
+        return on_construct_;
+    }
+
+    // emitted before component is removed
+    inline signal<entity_type>& on_destroy() {
+        return on_destroy_;
+    }
+
+    // emitted after component is replaced
+    inline signal<entity_type>& on_update() {
+        return on_update_;
+    }
+
+    // keep bit `component_id` of entity rows in `signatures` in sync with contained entities
+    inline void bind_signatures(signatures_type* signatures, uint32_t component_id) {
+        assert(size() == 0u);
+        signatures_ = signatures;
+        component_id_ = component_id;
+    }
+
+    // component of contained `e` is added or modified after `tick`, requires `tracks_changes()`
+    inline bool changed_since(entity_type e, tick_type tick) const {
+        assert(tracks_changes());
+        return ticks_[table_.at(e.index())] > tick;
+    }
+
+    // replace entities by `mapping[entity.index()]` keeping dense order, rebuilds sparse table
+    void remap(const std::vector<entity_type>& mapping) {
+        table_.clear();
+        const auto end = static_cast<index_type>(entity_.size());
+        for (index_type i = 1u; i != end; ++i) {
+            if (entity_[i] == nullptr) {
+                // tombstone
+                continue;
+            }
+            const entity_type e = mapping[entity_[i].index()];
+            entity_[i] = e;
+            table_.insert(e.index(), i);
+        }
+    }
+
 protected:
-    sparse_vector<index_type, 0u> table_;
+    inline static const tick_type stopped_clock = 0u;
+
+    inline void own(entity_type e) {
+        if (signatures_ != nullptr) {
+            signatures_->set(e.index(), component_id_);
+        }
+    }
+
+    inline void disown(entity_type e) {
+        if (signatures_ != nullptr) {
+            signatures_->reset(e.index(), component_id_);
+        }
+    }
+
+    table_type table_;
     entity_vector_type entity_;
+    // modification tick per dense slot, empty if changes are not tracked
+    std::pmr::vector<tick_type> ticks_;
+    const tick_type* clock_;
+    signal<entity_type> on_construct_;
+    signal<entity_type> on_destroy_;
+    signal<entity_type> on_update_;
+    signatures_type* signatures_ = nullptr;
+    uint32_t component_id_ = 0u;
 };
 
 template<typename EntityType, typename DataType>
@@ -70,40 +185,169 @@ public:
     using entity_type = entity_value<EntityType>;
     using index_type = typename entity_spec<EntityType>::index_type;
     using data_type = DataType;
+    using traits_type = component_traits<DataType>;
 
     constexpr static bool is_empty_data = std::is_empty<data_type>::value;
-
-    entity_map() {
+    constexpr static bool is_soa_data = traits_type::soa_layout::size != 0u;
+
+    using data_vector_type = std::conditional_t<is_soa_data,
+            typename soa_vector_for<data_type, typename traits_type::soa_layout>::type,
+            std::conditional_t<traits_type::chunk_size != 0u,
+                    paged_vector<data_type, traits_type::chunk_size>,
+                    std::pmr::vector<data_type>>>;
+
+    using tick_type = typename base_type::tick_type;
+
+    explicit entity_map(typename base_type::page_pool_type* page_pool = nullptr,
+                        std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+                        const tick_type* clock = nullptr)
+            : base_type{page_pool, traits_type::page_size, resource, clock},
+              data_{resource} {
+        if constexpr (traits_type::initial_capacity != 0u) {
+            reserve(traits_type::initial_capacity);
+        }
         // null data
         data_.emplace_back();
+        if constexpr (traits_type::track_changes) {
+            base_type::ticks_.emplace_back(0u);
+        }
     }
 
     ~entity_map() override = default;
 
+    // returns reference to new component, nothing for SoA storage
     template<typename ...Args>
-    DataType& emplace(entity_type e, Args&& ...args) {
+    decltype(auto) emplace(entity_type e, Args&& ...args) {
 
         assert(!base_type::has(e));
 
+        if constexpr (traits_type::growth_percent != 0u) {
+            grow_if_full();
+        }
+
         auto di = static_cast<index_type>(base_type::entity_.size());
         base_type::entity_.emplace_back(e);
         base_type::table_.insert(e.index(), di);
+        base_type::own(e);
+        if constexpr (traits_type::track_changes) {
+            base_type::ticks_.push_back(*base_type::clock_);
+        }
 
         if constexpr (is_empty_data) {
+            constructed(e);
             return data_[0];
+        } else if constexpr (is_soa_data) {
+            data_.emplace_back(std::forward<Args>(args)...);
+            constructed(e);
+        } else if constexpr (std::is_constructible_v<data_type, Args&&...>) {
+            auto& data = data_.emplace_back(std::forward<Args>(args)...);
+            constructed(e);
+            return data;
         } else {
+            // aggregate initialization is not supported by `emplace_back`, temporary is moved
+            auto& data = data_.emplace_back(data_type{std::forward<Args>(args)...});
+            constructed(e);
+            return data;
+        }
+    }
+
+    // replace component of contained entity, returns reference to component, nothing for SoA storage
+    template<typename ...Args>
+    decltype(auto) replace(entity_type e, Args&& ...args) {
+        assert(base_type::has(e));
+        const index_type index = base_type::table_.at(e.index());
+        touch(index);
+        if constexpr (is_empty_data) {
+            updated(e);
+            return data_[0];
+        } else if constexpr (is_soa_data) {
             if constexpr (std::is_aggregate_v<data_type>) {
-                return data_.emplace_back(data_type{args...});
+                data_.set(index, data_type{std::forward<Args>(args)...});
+            } else {
+                data_.set(index, data_type(std::forward<Args>(args)...));
+            }
+            updated(e);
+        } else {
+            // new value is constructed by the same rule as in `emplace`
+            auto& data = data_[index];
+            if constexpr (sizeof...(Args) == 1u && (std::is_same_v<std::decay_t<Args>, data_type> && ...)) {
+                data = (std::forward<Args>(args), ...);
+            } else if constexpr (std::is_constructible_v<data_type, Args&&...>) {
+                data = data_type(std::forward<Args>(args)...);
             } else {
-                return data_.emplace_back(args...);
+                data = data_type{std::forward<Args>(args)...};
             }
+            updated(e);
+            return data;
+        }
+    }
+
+    // insert range of entities with default components, storage is reserved once
+    template<typename It>
+    void insert(It begin, const It end) {
+        const auto first = static_cast<index_type>(base_type::entity_.size());
+        reserve(base_type::size() + static_cast<size_t>(std::distance(begin, end)));
+        for (; begin != end; ++begin) {
+            insert_entity(*begin);
+            if constexpr (!is_empty_data) {
+                data_.emplace_back();
+            }
+        }
+        constructed_from(first);
+    }
+
+    // insert range of entities with copies of `value`, storage is reserved once
+    template<typename It>
+    void insert(It begin, const It end, const data_type& value) {
+        const auto first = static_cast<index_type>(base_type::entity_.size());
+        reserve(base_type::size() + static_cast<size_t>(std::distance(begin, end)));
+        for (; begin != end; ++begin) {
+            insert_entity(*begin);
+            if constexpr (!is_empty_data) {
+                data_.emplace_back(value);
+            }
+        }
+        constructed_from(first);
+    }
+
+    // replace components of range of contained entities by copies of `value`
+    template<typename It>
+    void replace(It begin, const It end, const data_type& value) {
+        for (; begin != end; ++begin) {
+            assert(base_type::has(*begin));
+            const auto index = base_type::table_.at(begin->index());
+            touch(index);
+            if constexpr (is_soa_data) {
+                data_.set(index, value);
+            } else if constexpr (!is_empty_data) {
+                data_[index] = value;
+            }
+            updated(*begin);
+        }
+    }
+
+    void reserve(size_t size) {
+        base_type::entity_.reserve(size + 1u);
+        if constexpr (!is_empty_data) {
+            data_.reserve(size + 1u);
+        }
+        if constexpr (traits_type::track_changes) {
+            base_type::ticks_.reserve(size + 1u);
         }
     }
 
     void erase(entity_type e) {
         assert(base_type::has(e));
+        if (!base_type::on_destroy_.empty()) {
+            base_type::on_destroy_.emit(e);
+        }
 
         const auto index = base_type::table_.get_and_remove(e.index());
+        base_type::disown(e);
+        if constexpr (traits_type::in_place_delete) {
+            bury(index);
+            return;
+        }
         const bool swap_with_back = index < base_type::entity_.size() - 1u;
 
         if (swap_with_back) {
@@ -111,42 +355,78 @@ public:
             base_type::table_.replace(back_entity.index(), index);
             std::swap(base_type::entity_.back(), base_type::entity_[index]);
 
-            if constexpr (!is_empty_data) {
-//                data_[index] = std::move(data_.back());
-                std::swap(data_.back(), data_[index]);
-            }
+            move_slot(index, static_cast<index_type>(base_type::entity_.size() - 1u));
         }
         base_type::entity_.pop_back();
-        if constexpr (!is_empty_data) {
-            data_.pop_back();
-        }
+        truncate_slots(base_type::entity_.size());
     }
 
-    DataType& get(entity_type e) {
+    // SoA components are gathered by value, component is stamped as changed if tracked
+    decltype(auto) get(entity_type e) {
         assert(base_type::has(e));
+        if constexpr (traits_type::track_changes) {
+            touch(base_type::table_.at(e.index()));
+        }
         const index_type index = is_empty_data ? 0u : base_type::table_.at(e.index());
-        return data_[index];
+        if constexpr (is_soa_data) {
+            return data_.get(index);
+        } else {
+            return data_[index];
+        }
     }
 
-    DataType& get_or_create(entity_type e) {
+    decltype(auto) get_or_create(entity_type e) {
         if (!base_type::has(e)) {
             emplace(e);
         }
         return get(e);
     }
 
-    const DataType& get_or_default(entity_type e) const {
+    decltype(auto) get_or_default(entity_type e) const {
         if constexpr (is_empty_data) {
             return data_[0u];
+        } else if constexpr (is_soa_data) {
+            return data_.get(base_type::has(e) ? base_type::table_.at(e.index()) : 0u);
         } else {
             return data_[base_type::has(e) ? base_type::table_.at(e.index()) : 0u];
         }
     }
 
-    const DataType& get(entity_type e) const {
+    decltype(auto) get(entity_type e) const {
         assert(base_type::has(e));
         const index_type index = is_empty_data ? 0u : base_type::table_.at(e.index());
-        return data_[index];
+        if constexpr (is_soa_data) {
+            return data_.get(index);
+        } else {
+            return data_[index];
+        }
+    }
+
+    // single field of SoA component, stamped as changed like mutable `get`
+    template<auto Field>
+    inline field_type_t<Field>& field(entity_type e) {
+        static_assert(is_soa_data);
+        assert(base_type::has(e));
+        const index_type index = base_type::table_.at(e.index());
+        touch(index);
+        return data_.template field<Field>(index);
+    }
+
+    template<auto Field>
+    inline const field_type_t<Field>& field(entity_type e) const {
+        static_assert(is_soa_data);
+        assert(base_type::has(e));
+        return data_.template field<Field>(base_type::table_.at(e.index()));
+    }
+
+    /**
+     * field values of SoA components in dense order, matching `begin()..end()` entities,
+     * writes through span are not stamped as changed and don't emit `on_update`
+     **/
+    template<auto Field>
+    inline field_span<field_type_t<Field>> span() const {
+        static_assert(is_soa_data);
+        return {data_.template data<Field>() + 1u, base_type::size()};
     }
 
     void emplace_dyn(entity_type e) override {
@@ -157,8 +437,338 @@ public:
         erase(e);
     }
 
+    void destroy_dyn() override {
+        std::pmr::polymorphic_allocator<entity_map> allocator{base_type::resource()};
+        this->~entity_map();
+        allocator.deallocate(this, 1u);
+    }
+
+    void erase_dyn(const entity_type* begin, const entity_type* end) override {
+        erase(begin, end);
+    }
+
+    /**
+     * batched erase, entities not contained in map are skipped:
+     * 1. mark dense slots of erased entities as null
+     * 2. fill marked slots left in front of new size with alive entities from the back
+     * 3. truncate dense arrays once
+     **/
+    template<typename It>
+    void erase(const It begin, const It end) {
+        auto& entities = base_type::entity_;
+        auto& table = base_type::table_;
+
+        if constexpr (traits_type::in_place_delete) {
+            for (auto it = begin; it != end; ++it) {
+                const auto index = table.at(it->index());
+                if (index != 0u) {
+                    if (!base_type::on_destroy_.empty()) {
+                        base_type::on_destroy_.emit(*it);
+                    }
+                    table.remove(it->index());
+                    base_type::disown(*it);
+                    bury(index);
+                }
+            }
+            return;
+        }
+
+        index_type count{0u};
+        for (auto it = begin; it != end; ++it) {
+            // null slot is at dense index 0
+            auto& slot = entities[table.at(it->index())];
+            if (slot != nullptr) {
+                if (!base_type::on_destroy_.empty()) {
+                    base_type::on_destroy_.emit(*it);
+                }
+                slot = entity_type::null;
+                base_type::disown(*it);
+                ++count;
+            }
+        }
+
+        if (count == 0u) {
+            return;
+        }
+
+        const index_type size = base_type::size() - count;
+        auto back = static_cast<index_type>(entities.size() - 1u);
+        for (auto it = begin; it != end; ++it) {
+            const auto i = it->index();
+            const auto index = table.at(i);
+            if (index != 0u) {
+                table.remove(i);
+                if (index <= size) {
+                    while (entities[back] == nullptr) {
+                        --back;
+                    }
+                    const entity_type back_entity = entities[back];
+                    entities[index] = back_entity;
+                    entities[back] = entity_type::null;
+                    table.replace(back_entity.index(), index);
+                    move_slot(index, back);
+                }
+            }
+        }
+
+        entities.resize(size + 1u);
+        truncate_slots(entities.size());
+    }
+
+    /**
+     * reorder dense entities and data together, sparse table is rewritten.
+     * `compare` takes two components or two entities (for empty components),
+     * `algorithm` is `std_sort` or `insertion_sort` for pools which are almost sorted already
+     **/
+    template<typename Compare, typename Sort = std_sort>
+    void sort(Compare compare, Sort algorithm = Sort{}) {
+        pack();
+        const auto& entities = base_type::entity_;
+        std::pmr::vector<index_type> order(entities.size(), base_type::resource());
+        for (index_type i = 0u; i != order.size(); ++i) {
+            order[i] = i;
+        }
+
+        if constexpr (!is_empty_data && std::is_invocable_v<Compare, const data_type&, const data_type&>) {
+            algorithm(order.begin() + 1, order.end(), [this, &compare](index_type a, index_type b) {
+                return compare(data_at(a), data_at(b));
+            });
+        } else {
+            algorithm(order.begin() + 1, order.end(), [&entities, &compare](index_type a, index_type b) {
+                return compare(entities[a], entities[b]);
+            });
+        }
+
+        permute(order);
+    }
+
+    /**
+     * reorder dense arrays so entities shared with `other` pool come first
+     * in the same relative order as in `other`, rest entities follow in unspecified order.
+     * Views over both pools then read both data arrays sequentially
+     **/
+    void respect(const entity_map_base<EntityType>& other) {
+        pack();
+        auto& entities = base_type::entity_;
+        auto& table = base_type::table_;
+        index_type position{1u};
+        for (const auto e : other) {
+            if (base_type::has(e)) {
+                const index_type current = table.at(e.index());
+                if (current != position) {
+                    const entity_type displaced = entities[position];
+                    std::swap(entities[position], entities[current]);
+                    table.replace(e.index(), position);
+                    table.replace(displaced.index(), current);
+                    swap_slot(position, current);
+                }
+                ++position;
+            }
+        }
+    }
+
+    /**
+     * remove tombstones left by erase with `in_place_delete` policy in one pass,
+     * order of alive entities is preserved
+     **/
+    void pack() {
+        if (tombstones_ == 0u) {
+            return;
+        }
+        auto& entities = base_type::entity_;
+        index_type to{1u};
+        for (index_type from = 1u; from != entities.size(); ++from) {
+            const entity_type e = entities[from];
+            if (e != nullptr) {
+                if (to != from) {
+                    entities[to] = e;
+                    base_type::table_.replace(e.index(), to);
+                    move_slot(to, from);
+                }
+                ++to;
+            }
+        }
+        entities.resize(to);
+        truncate_slots(to);
+        tombstones_ = 0u;
+    }
+
+    // number of dense slots erased with `in_place_delete` policy and not packed yet
+    inline index_type tombstones() const {
+        return tombstones_;
+    }
+
 private:
-    std::vector<data_type> data_;
+
+    // mark dense slot as erased, component resources are released right away
+    void bury(index_type index) {
+        base_type::entity_[index] = entity_type::null;
+        if constexpr (!is_empty_data && !is_soa_data) {
+            data_[index] = data_type{};
+        }
+        ++tombstones_;
+    }
+
+    // append entity to reserved dense array and sparse table, without growth policy
+    inline void insert_entity(entity_type e) {
+        assert(!base_type::has(e));
+        auto& entities = base_type::entity_;
+        base_type::table_.insert(e.index(), static_cast<index_type>(entities.size()));
+        entities.push_back(e);
+        base_type::own(e);
+        if constexpr (traits_type::track_changes) {
+            base_type::ticks_.push_back(*base_type::clock_);
+        }
+    }
+
+    inline void constructed(entity_type e) const {
+        if (!base_type::on_construct_.empty()) {
+            base_type::on_construct_.emit(e);
+        }
+    }
+
+    // emit construction of entities appended from dense index `first`
+    inline void constructed_from(index_type first) const {
+        if (!base_type::on_construct_.empty()) {
+            const auto& entities = base_type::entity_;
+            for (auto i = first; i != entities.size(); ++i) {
+                base_type::on_construct_.emit(entities[i]);
+            }
+        }
+    }
+
+    inline void updated(entity_type e) const {
+        if (!base_type::on_update_.empty()) {
+            base_type::on_update_.emit(e);
+        }
+    }
+
+    // stamp dense slot with current tick
+    inline void touch([[maybe_unused]] index_type index) {
+        if constexpr (traits_type::track_changes) {
+            base_type::ticks_[index] = *base_type::clock_;
+        }
+    }
+
+    // move component data and tick of dense slot
+    inline void move_slot(index_type to, index_type from) {
+        if constexpr (!is_empty_data) {
+            move_data(to, from);
+        }
+        if constexpr (traits_type::track_changes) {
+            base_type::ticks_[to] = base_type::ticks_[from];
+        }
+    }
+
+    inline void swap_slot(index_type i, index_type j) {
+        if constexpr (!is_empty_data) {
+            swap_data(i, j);
+        }
+        if constexpr (traits_type::track_changes) {
+            std::swap(base_type::ticks_[i], base_type::ticks_[j]);
+        }
+    }
+
+    // shrink component data and ticks to `size` dense slots (including null slot)
+    inline void truncate_slots([[maybe_unused]] size_t size) {
+        if constexpr (!is_empty_data) {
+            while (data_.size() != size) {
+                data_.pop_back();
+            }
+        }
+        if constexpr (traits_type::track_changes) {
+            base_type::ticks_.resize(size);
+        }
+    }
+
+    /**
+     * move element from dense index `order[i]` to `i` following permutation cycles,
+     * so every element is moved once, `order` is reset to identity
+     **/
+    void permute(std::pmr::vector<index_type>& order) {
+        auto& entities = base_type::entity_;
+        for (index_type i = 1u; i != order.size(); ++i) {
+            if (order[i] == i) {
+                continue;
+            }
+            const entity_type entity = entities[i];
+            [[maybe_unused]] auto data = take_data(i);
+            [[maybe_unused]] const tick_type tick = traits_type::track_changes ? base_type::ticks_[i] : 0u;
+            index_type current = i;
+            for (index_type next = order[current]; next != i; next = order[current]) {
+                entities[current] = entities[next];
+                move_slot(current, next);
+                order[current] = current;
+                current = next;
+            }
+            entities[current] = entity;
+            if constexpr (!is_empty_data) {
+                put_data(current, std::move(data));
+            }
+            if constexpr (traits_type::track_changes) {
+                base_type::ticks_[current] = tick;
+            }
+            order[current] = current;
+        }
+
+        for (index_type i = 1u; i != entities.size(); ++i) {
+            base_type::table_.replace(entities[i].index(), i);
+        }
+    }
+
+    inline decltype(auto) data_at(index_type i) const {
+        if constexpr (is_soa_data) {
+            return data_.get(i);
+        } else {
+            return data_[i];
+        }
+    }
+
+    inline data_type take_data(index_type i) {
+        if constexpr (is_soa_data) {
+            return data_.get(i);
+        } else if constexpr (is_empty_data) {
+            return {};
+        } else {
+            return std::move(data_[i]);
+        }
+    }
+
+    inline void put_data(index_type i, data_type&& data) {
+        if constexpr (is_soa_data) {
+            data_.set(i, data);
+        } else {
+            data_[i] = std::move(data);
+        }
+    }
+
+    inline void swap_data(index_type i, index_type j) {
+        if constexpr (is_soa_data) {
+            data_.swap(i, j);
+        } else {
+            std::swap(data_[i], data_[j]);
+        }
+    }
+
+    inline void move_data(index_type to, index_type from) {
+        if constexpr (is_soa_data) {
+            data_.move(to, from);
+        } else {
+            data_[to] = std::move(data_[from]);
+        }
+    }
+
+    void grow_if_full() {
+        const auto capacity = base_type::entity_.capacity();
+        if (base_type::entity_.size() == capacity) {
+            const auto growth = capacity * traits_type::growth_percent / 100u;
+            // reserve counts null element
+            reserve(capacity + (growth != 0u ? growth : 1u) - 1u);
+        }
+    }
+
+    data_vector_type data_;
+    index_type tombstones_{0u};
 };
 
 }
@@ -1,8 +1,13 @@
 #pragma once
 
 #include <cstdint>
+#include <cassert>
 #include <vector>
+#include <iterator>
+#include <atomic>
+#include <memory_resource>
 #include "entity_value.h"
+#include "bit_count.h"
 
 namespace ecxx {
 
@@ -15,8 +20,12 @@ public:
     using index_type = typename spec::index_type;
     using version_type = typename spec::version_type;
 
-    basic_entity_pool() {
+    explicit basic_entity_pool(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : list_{resource},
+              alive_{resource},
+              pending_{resource} {
         list_.emplace_back(value_type::null);
+        alive_.emplace_back(0u);
     }
 
     value_type allocate() {
@@ -25,33 +34,173 @@ public:
             value_type e{next_, node.version()};
             next_ = node.index();
             list_[e.index()] = e;
+            set_alive(e.index());
             --available_;
             return e;
         } else {
             value_type e{static_cast<index_type>(list_.size())};
             list_.emplace_back(e);
+            resize_alive();
+            set_alive(e.index());
             return e;
         }
     }
 
     template<typename It>
     void allocate(It begin, const It end) {
+        // drain recycled entities first
+        while (available_ && begin != end) {
+            const value_type node = list_[next_];
+            const value_type e{next_, node.version()};
+            next_ = node.index();
+            list_[e.index()] = e;
+            set_alive(e.index());
+            *begin = e;
+            ++begin;
+            --available_;
+        }
+
+        // then grow the list once and fill contiguous fresh indices
+        auto i = static_cast<index_type>(list_.size());
+        list_.resize(list_.size() + static_cast<size_t>(std::distance(begin, end)));
+        set_alive_range(i, static_cast<index_type>(list_.size()));
         while (begin != end) {
-            // TODO: batch
-            *begin = allocate();
+            const value_type e{i};
+            list_[i] = e;
+            *begin = e;
             ++begin;
+            ++i;
         }
     }
 
     void deallocate(value_type entity) {
         const auto i = entity.index();
         list_[i] = {next_, static_cast<version_type>(entity.version() + 1u)};
+        clear_alive(i);
         next_ = i;
         ++available_;
     }
 
+    template<typename It>
+    void deallocate(It begin, const It end) {
+        index_type count{0u};
+        index_type head = next_;
+        while (begin != end) {
+            const value_type entity = *begin;
+            const auto i = entity.index();
+            list_[i] = {head, static_cast<version_type>(entity.version() + 1u)};
+            clear_alive(i);
+            head = i;
+            ++count;
+            ++begin;
+        }
+        next_ = head;
+        available_ += count;
+    }
+
+    /**
+     * Concurrent allocation mode:
+     *  1. `begin_concurrent` on owner thread, snapshots recycled entities
+     *  2. `allocate_concurrent` from any thread, lock-free
+     *  3. `end_concurrent` on owner thread, commits all minted entities to the pool
+     * handles are valid right after allocation, but pool doesn't treat them as alive until committed.
+     * no other pool modifications are allowed between begin and end.
+     */
+    void begin_concurrent() {
+        assert(!concurrent_);
+        pending_.resize(available_);
+        // free-list head goes to the back
+        index_type node = next_;
+        for (index_type i = available_; i != 0u; --i) {
+            pending_[i - 1u] = node;
+            node = list_[node].index();
+        }
+        cursor_.store(static_cast<int64_t>(available_), std::memory_order_relaxed);
+#ifndef NDEBUG
+        concurrent_ = true;
+#endif
+    }
+
+    value_type allocate_concurrent() {
+        assert(concurrent_);
+        return minted(cursor_.fetch_sub(1, std::memory_order_relaxed));
+    }
+
+    // reserve the whole range with single atomic operation
+    template<typename It>
+    void allocate_concurrent(It begin, const It end) {
+        assert(concurrent_);
+        const auto count = static_cast<int64_t>(std::distance(begin, end));
+        int64_t c = cursor_.fetch_sub(count, std::memory_order_relaxed);
+        while (begin != end) {
+            *begin = minted(c);
+            --c;
+            ++begin;
+        }
+    }
+
+    void end_concurrent() {
+        assert(concurrent_);
+        const int64_t c = cursor_.load(std::memory_order_acquire);
+        const auto recycled_end = static_cast<index_type>(c > 0 ? c : 0);
+        for (index_type i = recycled_end; i != static_cast<index_type>(pending_.size()); ++i) {
+            const index_type index = pending_[i];
+            list_[index] = {index, list_[index].version()};
+            set_alive(index);
+        }
+        // remaining pending entities are still linked in original order
+        available_ = recycled_end;
+        next_ = recycled_end != 0u ? pending_[recycled_end - 1u] : 0u;
+
+        if (c < 0) {
+            auto i = static_cast<index_type>(list_.size());
+            list_.resize(list_.size() + static_cast<size_t>(-c));
+            set_alive_range(i, static_cast<index_type>(list_.size()));
+            for (; i != static_cast<index_type>(list_.size()); ++i) {
+                list_[i] = value_type{i};
+            }
+        }
+
+        pending_.clear();
+        cursor_.store(0, std::memory_order_relaxed);
+#ifndef NDEBUG
+        concurrent_ = false;
+#endif
+    }
+
+    /**
+     * renumber alive entities into dense [1, size] index range keeping their order and versions,
+     * drops all recycled entities.
+     * returns remap table: old index -> new entity (null for dead indices)
+     */
+    std::vector<value_type> compact() {
+        assert(!concurrent_);
+        std::vector<value_type> remap(list_.size());
+        const auto end = static_cast<index_type>(list_.size());
+        index_type next{1u};
+        for (index_type i = 1u; i != end; ++i) {
+            const value_type e = list_[i];
+            if (e.index() == i) {
+                const value_type compacted{next, e.version()};
+                remap[i] = compacted;
+                list_[next] = compacted;
+                ++next;
+            }
+        }
+
+        list_.resize(next);
+        list_.shrink_to_fit();
+        alive_.clear();
+        set_alive_range(1u, next);
+        alive_.shrink_to_fit();
+        available_ = 0u;
+        next_ = 0u;
+        return remap;
+    }
+
     inline void reserve(size_t size) {
         list_.reserve(size + 1);
+        alive_.reserve((size + 64u) >> 6u);
     }
 
     inline index_type size() const {
@@ -74,6 +223,27 @@ public:
         return i < list_.size() && i == list_[i].index();
     }
 
+    // alive slot stores the entity itself, dead slot stores next free index and the next version
+    inline bool valid(value_type e) const {
+        const index_type i = e.index();
+        return i != 0u && i < list_.size() && list_[i] == e;
+    }
+
+    // write validity of each entity from range to output
+    template<typename It, typename Out>
+    Out valid(It begin, const It end, Out out) const {
+        const auto size = list_.size();
+        const value_type* list = list_.data();
+        while (begin != end) {
+            const value_type e = *begin;
+            const index_type i = e.index();
+            *out = i != 0u && i < size && list[i] == e;
+            ++out;
+            ++begin;
+        }
+        return out;
+    }
+
 
     inline index_type available_for_recycling() const {
         return available_;
@@ -84,11 +254,14 @@ public:
         static_assert(std::is_invocable_v<Func, value_type>);
 
         if (available_) {
-            const index_type end = list_.size();
-            for (index_type i = 1u; i != end; ++i) {
-                const value_type e = list_[i];
-                if (e.index() == i) {
-                    func(e);
+            // walk alive bits only, re-read the word after each call to respect destroy inside `func`
+            const auto words = alive_.size();
+            for (size_t word = 0u; word != words; ++word) {
+                uint64_t bits = alive_[word];
+                while (bits != 0u) {
+                    const auto bit = count_trailing_zeros(bits);
+                    func(list_[(word << 6u) + bit]);
+                    bits = alive_[word] & ((~uint64_t{0u} << bit) << 1u);
                 }
             }
         } else {
@@ -100,9 +273,54 @@ public:
     }
 
 private:
+
+    inline void resize_alive() {
+        alive_.resize((list_.size() + 63u) >> 6u, 0u);
+    }
+
+    inline void set_alive(index_type i) {
+        alive_[i >> 6u] |= uint64_t{1u} << (i & 63u);
+    }
+
+    inline void clear_alive(index_type i) {
+        alive_[i >> 6u] &= ~(uint64_t{1u} << (i & 63u));
+    }
+
+    // [begin, end) are fresh indices at the end of the list
+    void set_alive_range(index_type begin, const index_type end) {
+        resize_alive();
+        while (begin != end && (begin & 63u) != 0u) {
+            set_alive(begin++);
+        }
+        while (end - begin >= 64u) {
+            alive_[begin >> 6u] = ~uint64_t{0u};
+            begin += 64u;
+        }
+        while (begin != end) {
+            set_alive(begin++);
+        }
+    }
+
+    // cursor value > 0 points to pending recycled entity, otherwise to fresh index after the list
+    inline value_type minted(int64_t cursor) const {
+        if (cursor > 0) {
+            const index_type i = pending_[cursor - 1];
+            return {i, list_[i].version()};
+        }
+        return value_type{static_cast<index_type>(static_cast<int64_t>(list_.size()) - cursor)};
+    }
+
     index_type available_{0u};
     index_type next_{0u};
-    std::vector<value_type> list_;
+    std::pmr::vector<value_type> list_;
+    // alive bit per list slot
+    std::pmr::vector<uint64_t> alive_;
+
+    std::pmr::vector<index_type> pending_;
+    std::atomic<int64_t> cursor_{0};
+#ifndef NDEBUG
+    bool concurrent_{false};
+#endif
 };
 
 }
\ No newline at end of file
@@ -1,25 +1,61 @@
 #pragma once
 
 #include <cstdint>
+#include <type_traits>
 
 namespace ecxx {
 
+namespace details {
+
+// smallest unsigned integer type to hold Bits
+template<uint32_t Bits>
+using uint_for_bits = std::conditional_t<(Bits <= 8u), uint8_t,
+        std::conditional_t<(Bits <= 16u), uint16_t,
+                std::conditional_t<(Bits <= 32u), uint32_t, uint64_t>>>;
+
+}
+
+/**
+ * entity value layout: [version bits][index bits]
+ * ValueType - unsigned integer type to store entity value
+ * IndexBits - number of low bits reserved for entity index, the rest is for version
+ **/
+template<typename ValueType, uint32_t IndexBits>
+struct basic_entity_spec {
+    static_assert(std::is_unsigned_v<ValueType>);
+    static_assert(IndexBits > 0u && IndexBits < (sizeof(ValueType) * 8u));
+
+    using value_type = ValueType;
+    using index_type = details::uint_for_bits<IndexBits>;
+    using version_type = details::uint_for_bits<sizeof(ValueType) * 8u - IndexBits>;
+
+    static constexpr uint32_t index_bits = IndexBits;
+    static constexpr value_type index_cap = (value_type{1u} << index_bits);
+    static constexpr value_type index_mask = index_cap - 1u;
+
+    static constexpr uint32_t version_bits = sizeof(ValueType) * 8u - IndexBits;
+    static constexpr value_type version_mask = static_cast<value_type>(~value_type{0u}) >> index_bits;
+    static constexpr value_type version_cap = version_mask + 1u;
+};
+
+/**
+ * entity spec is selected by Tag type,
+ * custom index/version split could be declared with specialization:
+ *
+ * struct my_entity_tag;
+ * template<> struct entity_spec<my_entity_tag> : basic_entity_spec<uint32_t, 24u> {};
+ **/
 template<typename Tag>
 struct entity_spec;
 
+// 20-bit index / 12-bit version
+template<>
+struct entity_spec<uint32_t> : basic_entity_spec<uint32_t, 20u> {
+};
+
+// 32-bit index / 32-bit version
 template<>
-struct entity_spec<uint32_t> {
-    using value_type = uint32_t;
-    using index_type = uint32_t;
-    using version_type = uint16_t;
-
-    static constexpr uint32_t index_bits = 20u;
-    static constexpr uint32_t index_cap = (1u << index_bits);
-    static constexpr uint32_t index_mask = index_cap - 1u;
-
-    static constexpr uint32_t version_bits = 12u;
-    static constexpr uint32_t version_cap = (1u << version_bits);
-    static constexpr uint32_t version_mask = version_cap - 1u;
+struct entity_spec<uint64_t> : basic_entity_spec<uint64_t, 32u> {
 };
 
-}
\ No newline at end of file
+}
@@ -26,24 +26,24 @@ public:
     }
 
     inline constexpr entity_value(index_type i, version_type v) noexcept
-            : value_{i | (v << spec::index_bits)} {
+            : value_{static_cast<value_type>(i) | ((static_cast<value_type>(v) & spec::version_mask) << spec::index_bits)} {
 
     }
 
     inline constexpr version_type version() const noexcept {
-        return (value_ >> spec::index_bits) & spec::version_mask;
+        return static_cast<version_type>((value_ >> spec::index_bits) & spec::version_mask);
     }
 
     inline constexpr void version(version_type v) noexcept {
-        value_ = (value_ & spec::index_mask) | (v << spec::index_bits);
+        value_ = (value_ & spec::index_mask) | ((static_cast<value_type>(v) & spec::version_mask) << spec::index_bits);
     }
 
     inline constexpr index_type index() const noexcept {
-        return value_ & spec::index_mask;
+        return static_cast<index_type>(value_ & spec::index_mask);
     }
 
     inline constexpr void index(index_type v) noexcept {
-        value_ = (value_ & ~spec::index_mask) | v;
+        value_ = (value_ & ~spec::index_mask) | (static_cast<value_type>(v) & spec::index_mask);
     }
 
     inline bool operator==(entity_value<T> other) const {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <utility>
 #include "entity_wrapper.h"
 #include "world.h"
 
@@ -19,7 +20,7 @@ inline void entity_wrapper<T>::destroy() {
 template<typename T>
 template<typename Component, typename ...Args>
 inline Component& entity_wrapper<T>::set(Args&& ... args) {
-    return world_.template assign<Component>(entity_, args...);
+    return world_.template assign<Component>(entity_, std::forward<Args>(args)...);
 }
 
 template<typename T>
@@ -1,30 +1,73 @@
 #pragma once
 
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <string_view>
+
 namespace ecxx {
 namespace details {
 
 template<typename Identity>
 struct identity_counter {
-    static Identity counter;
+    static std::atomic<Identity> counter;
 
     inline static Identity next() {
-        return counter++;
+        return counter.fetch_add(1u, std::memory_order_relaxed);
     }
 };
 
 template<typename Identity>
-Identity identity_counter<Identity>::counter = Identity(0);
+std::atomic<Identity> identity_counter<Identity>::counter{Identity(0)};
+
+template<typename T>
+constexpr std::string_view pretty_function() noexcept {
+#ifdef _MSC_VER
+    return __FUNCSIG__;
+#else
+    return __PRETTY_FUNCTION__;
+#endif
+}
+
+// type name is located in signature of known type
+constexpr std::string_view type_name_probe = pretty_function<double>();
+constexpr size_t type_name_prefix = type_name_probe.find("double");
+constexpr size_t type_name_suffix = type_name_probe.size() - type_name_prefix - std::string_view{"double"}.size();
+
+// FNV-1a
+constexpr uint64_t hash_string(std::string_view str) noexcept {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : str) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+    }
+    return hash;
+}
 
 }
 
 // 1. match between TU
 // 2. starts from 0 for each Identity type
+// 3. depends on initialization order, so it's not stable between processes, see `type_hash`
 template<typename T, typename Identity>
 struct identity_generator {
     static const Identity value;
 };
 
 template<typename T, typename Identity>
-const Identity identity_generator<T, Identity>::value = details::identity_counter<Identity>::next();;
+const Identity identity_generator<T, Identity>::value = details::identity_counter<Identity>::next();
+
+// compiler-specific spelling of type name, available at compile-time
+template<typename T>
+constexpr std::string_view type_name() noexcept {
+    constexpr std::string_view name = details::pretty_function<T>();
+    return name.substr(details::type_name_prefix,
+                       name.size() - details::type_name_prefix - details::type_name_suffix);
+}
 
-}
\ No newline at end of file
+// hash of type name: compile-time constant, stable between processes built by the same compiler
+template<typename T>
+constexpr uint64_t type_hash() noexcept {
+    return details::hash_string(type_name<T>());
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace ecxx {
+
+/**
+ * memory resource proxy counting bytes allocated through it,
+ * use it as world resource to measure memory used by the world
+ **/
+class memory_counter : public std::pmr::memory_resource {
+public:
+    explicit memory_counter(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+            : upstream_{upstream} {
+    }
+
+    inline size_t bytes() const {
+        return bytes_;
+    }
+
+    inline size_t peak() const {
+        return peak_;
+    }
+
+    inline size_t allocations() const {
+        return allocations_;
+    }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* ptr = upstream_->allocate(bytes, alignment);
+        bytes_ += bytes;
+        peak_ = bytes_ > peak_ ? bytes_ : peak_;
+        ++allocations_;
+        return ptr;
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        upstream_->deallocate(ptr, bytes, alignment);
+        bytes_ -= bytes;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    size_t bytes_ = 0u;
+    size_t peak_ = 0u;
+    size_t allocations_ = 0u;
+};
+
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <new>
+#include <utility>
+#include <vector>
+#include <memory_resource>
+#include "bit_count.h"
+
+namespace ecxx {
+
+/**
+ * vector of fixed-size chunks: growth allocates new chunk without moving existing elements,
+ * so references are stable until element is removed.
+ * ChunkSize is number of elements per chunk, required to be power-of-two value
+ **/
+template<typename T, const uint32_t ChunkSize>
+class paged_vector {
+public:
+    static_assert(ChunkSize != 0u && (ChunkSize & (ChunkSize - 1u)) == 0u, "ChunkSize must be power-of-two");
+
+    static constexpr uint32_t chunk_bits = bit_count(ChunkSize - 1u);
+    static constexpr uint32_t chunk_mask = ChunkSize - 1u;
+
+    using value_type = T;
+
+    explicit paged_vector(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : chunks_{resource} {
+    }
+
+    paged_vector(const paged_vector&) = delete;
+
+    paged_vector& operator=(const paged_vector&) = delete;
+
+    ~paged_vector() {
+        while (size_ != 0u) {
+            pop_back();
+        }
+        for (T* chunk : chunks_) {
+            resource()->deallocate(chunk, sizeof(T) * ChunkSize, alignof(T));
+        }
+    }
+
+    inline T& operator[](size_t i) {
+        assert(i < size_);
+        return chunks_[i >> chunk_bits][i & chunk_mask];
+    }
+
+    inline const T& operator[](size_t i) const {
+        assert(i < size_);
+        return chunks_[i >> chunk_bits][i & chunk_mask];
+    }
+
+    inline T& back() {
+        return (*this)[size_ - 1u];
+    }
+
+    template<typename ...Args>
+    T& emplace_back(Args&& ...args) {
+        if (size_ == capacity()) {
+            add_chunk();
+        }
+        T* element = new(&chunks_[size_ >> chunk_bits][size_ & chunk_mask]) T(std::forward<Args>(args)...);
+        ++size_;
+        return *element;
+    }
+
+    void pop_back() {
+        assert(size_ != 0u);
+        back().~T();
+        --size_;
+    }
+
+    // allocate chunks for `count` elements, existing elements are never moved
+    void reserve(size_t count) {
+        while (capacity() < count) {
+            add_chunk();
+        }
+    }
+
+    inline size_t size() const {
+        return size_;
+    }
+
+    inline size_t capacity() const {
+        return chunks_.size() << chunk_bits;
+    }
+
+    inline std::pmr::memory_resource* resource() const {
+        return chunks_.get_allocator().resource();
+    }
+
+private:
+
+    void add_chunk() {
+        chunks_.push_back(static_cast<T*>(resource()->allocate(sizeof(T) * ChunkSize, alignof(T))));
+    }
+
+    // table of chunk pointers is the only array reallocated on growth
+    std::pmr::vector<T*> chunks_;
+    size_t size_ = 0u;
+};
+
+}
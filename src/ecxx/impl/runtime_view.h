@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <vector>
+#include <utility>
 
 #include "entity_map.h"
 
@@ -14,17 +16,20 @@ public:
     using map_type = entity_map_base<T>;
 
     using table_type = std::vector<map_type*>;
+    using excluded_type = std::vector<const map_type*>;
     using table_index_type = typename table_type::size_type;
 
     using indices_type = std::vector<table_index_type>;
 
-    using entity_vector_iterator = typename std::vector<entity_type>::iterator;
+    using entity_vector_iterator = typename map_type::entity_vector_iterator;
 
     class iterator {
     public:
-        iterator(table_type& table, entity_vector_iterator it)
-                : table_{table},
-                  it_{it} {
+        iterator(table_type& table, const excluded_type& excluded, entity_vector_iterator it)
+                : it_{it},
+                  table_{table},
+                  excluded_begin_{excluded.data()},
+                  excluded_end_{excluded.data() + excluded.size()} {
             skips();
         }
 
@@ -49,11 +54,20 @@ public:
         }
 
         inline bool valid(entity_type entity) const {
+            // skip tombstones of first map
+            if (entity == nullptr) {
+                return false;
+            }
             for (uint32_t i = 1u; i < table_.size(); ++i) {
                 if (!table_[i]->has(entity)) {
                     return false;
                 }
             }
+            for (auto* map = excluded_begin_; map != excluded_end_; ++map) {
+                if ((*map)->has(entity)) {
+                    return false;
+                }
+            }
             return true;
         }
 
@@ -72,11 +86,15 @@ public:
         entity_vector_iterator it_;
         entity_type ent_;
         table_type& table_;
+        const map_type* const* excluded_begin_;
+        const map_type* const* excluded_end_;
     };
 
-    explicit runtime_view_t(table_type& table)
+    // pivot is chosen only from `table`, entities contained in any of `excluded` are skipped
+    explicit runtime_view_t(table_type& table, excluded_type excluded = {})
             : access_{table},
-              table_{table} {
+              table_{table},
+              excluded_{std::move(excluded)} {
 
         std::sort(table_.begin(), table_.end(), [this](auto a, auto b) -> bool {
             return a->size() < b->size();
@@ -84,11 +102,11 @@ public:
     }
 
     iterator begin() {
-        return {table_, table_[0]->begin()};
+        return {table_, excluded_, table_[0]->begin()};
     }
 
     iterator end() {
-        return {table_, table_[0]->end()};
+        return {table_, excluded_, table_[0]->end()};
     }
 
     template<typename Func>
@@ -101,6 +119,7 @@ public:
 private:
     table_type access_;
     table_type table_;
+    excluded_type excluded_;
 };
 
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <array>
+#include <utility>
 
 #include "components_db.h"
+#include "view.h"
 
 namespace ecxx {
 
@@ -19,11 +21,11 @@ public:
 
     using indices_type = std::array<table_index_type, components_num>;
 
-    using entity_vector_iterator = typename std::vector<entity_type>::iterator;
+    using entity_vector_iterator = typename map_type::entity_vector_iterator;
 
     class iterator {
     public:
-        iterator(table_type& table, uint32_t it)
+        iterator(table_type& table, index_type it)
                 : table_{table},
                   it_{it} {
             skips();
@@ -54,6 +56,10 @@ public:
         }
 
         inline bool valid(entity_type entity) const {
+            // skip tombstones of first map
+            if (entity == nullptr) {
+                return false;
+            }
             for (uint32_t i = 1u; i < components_num; ++i) {
                 if (!table_[i]->has(entity)) {
                     return false;
@@ -75,14 +81,19 @@ public:
         }
 
     private:
-        uint32_t it_;
+        index_type it_;
         entity_type ent_;
         table_type& table_;
     };
 
-    explicit basic_rview(components_db <T>& db) {
+    explicit basic_rview(components_db <T>& db)
+            : basic_rview{db.template ensure<Component>()...} {
+    }
+
+    // pools are known at compile-time, see `static_world`
+    explicit basic_rview(entity_map <T, Component>& ...pools) {
         table_index_type i{};
-        ((access_[i] = table_[i] = &db.template ensure<Component>(), ++i), ...);
+        ((access_[i] = table_[i] = &pools, ++i), ...);
 
         std::sort(table_.begin(), table_.end(), [this](auto a, auto b) -> bool {
             return a->size() < b->size();
@@ -98,19 +109,34 @@ public:
     }
 
     template<typename Comp>
-    constexpr inline Comp& unsafe_get(table_index_type i, entity_type e) {
+    constexpr inline decltype(auto) unsafe_get(table_index_type i, entity_type e) {
         return static_cast<entity_map <T, Comp>*>(access_[i])->get(e);
     }
 
     template<typename Func>
     void each(Func func) {
+        each(func, std::index_sequence_for<Component...>{});
+    }
+
+private:
+
+    template<typename Comp, bool Write>
+    inline decltype(auto) get(table_index_type i, entity_type e) {
+        if constexpr (Write) {
+            return unsafe_get<Comp>(i, e);
+        } else {
+            return static_cast<const entity_map <T, Comp>*>(access_[i])->get(e);
+        }
+    }
+
+    // see `filtered_view::each`
+    template<typename Func, size_t ...I>
+    inline void each(Func& func, std::index_sequence<I...>) {
         for (auto e : *this) {
-            table_index_type i{0u};
-            func(unsafe_get<Component>(i++, e)...);
+            func(get<Component, details::writes_param<Func, I>()>(I, e)...);
         }
     }
 
-private:
     table_type access_;
     table_type table_;
 };
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <memory_resource>
+
+namespace ecxx {
+
+/**
+ * flat list of listeners called with entity,
+ * listener is function pointer with user context, for example:
+ * world.on_construct<position_t>().connect(+[](void* index, entity_type e) {...}, &spatial_index);
+ * listeners are not allowed to add or remove components of signalling pool
+ **/
+template<typename EntityType>
+class signal {
+public:
+    using listener_type = void (*)(void* context, EntityType entity);
+
+    explicit signal(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : listeners_{resource} {
+    }
+
+    void connect(listener_type listener, void* context = nullptr) {
+        listeners_.push_back({listener, context});
+    }
+
+    void disconnect(listener_type listener, void* context = nullptr) {
+        listeners_.erase(std::remove_if(listeners_.begin(), listeners_.end(), [=](const slot& s) {
+            return s.listener == listener && s.context == context;
+        }), listeners_.end());
+    }
+
+    inline bool empty() const {
+        return listeners_.empty();
+    }
+
+    inline void emit(EntityType entity) const {
+        for (const auto& s : listeners_) {
+            s.listener(s.context, entity);
+        }
+    }
+
+private:
+    struct slot {
+        listener_type listener;
+        void* context;
+    };
+
+    std::pmr::vector<slot> listeners_;
+};
+
+}
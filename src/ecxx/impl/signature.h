@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include <vector>
+#include <memory_resource>
+#include "bit_count.h"
+
+namespace ecxx {
+
+/**
+ * component bitmask per entity index, bit number is component type id.
+ * Rows are stored in single flat array, row width grows by 64-bit words
+ * when component type with bigger id is registered
+ **/
+template<typename IndexType>
+class entity_signatures {
+public:
+    using word_type = uint64_t;
+    static constexpr uint32_t word_bits = 64u;
+
+    explicit entity_signatures(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : bits_{resource} {
+    }
+
+    inline void set(IndexType index, uint32_t bit) {
+        if (index >= rows_ || (bit >> 6u) >= stride_) {
+            ensure(index, bit);
+        }
+        bits_[index * stride_ + (bit >> 6u)] |= mask(bit);
+    }
+
+    inline void reset(IndexType index, uint32_t bit) {
+        if (index < rows_ && (bit >> 6u) < stride_) {
+            bits_[index * stride_ + (bit >> 6u)] &= ~mask(bit);
+        }
+    }
+
+    inline bool test(IndexType index, uint32_t bit) const {
+        return index < rows_ && (bit >> 6u) < stride_ &&
+               (bits_[index * stride_ + (bit >> 6u)] & mask(bit)) != 0u;
+    }
+
+    // number of words per row
+    inline size_t stride() const {
+        return stride_;
+    }
+
+    // row of `stride()` words, or nullptr if nothing was set for index
+    inline const word_type* row(IndexType index) const {
+        return index < rows_ ? bits_.data() + index * stride_ : nullptr;
+    }
+
+    // call `func(bit)` for every set bit of row, func is allowed to reset bits of this row
+    template<typename Func>
+    void each(IndexType index, Func func) const {
+        if (index < rows_) {
+            for (size_t w = 0u; w != stride_; ++w) {
+                word_type word = bits_[index * stride_ + w];
+                while (word != 0u) {
+                    func(static_cast<uint32_t>(w * word_bits + count_trailing_zeros(word)));
+                    word &= word - 1u;
+                }
+            }
+        }
+    }
+
+    // move rows to new indices: `mapping[index].index()`, rows of null mapping are dropped
+    template<typename Entity>
+    void remap(const std::vector<Entity>& mapping) {
+        std::pmr::vector<word_type> bits(bits_.get_allocator());
+        size_t rows = 0u;
+        for (size_t i = 0u; i != std::min(rows_, mapping.size()); ++i) {
+            if (mapping[i] != nullptr) {
+                rows = std::max(rows, static_cast<size_t>(mapping[i].index()) + 1u);
+            }
+        }
+        bits.resize(rows * stride_);
+        for (size_t i = 0u; i != std::min(rows_, mapping.size()); ++i) {
+            if (mapping[i] != nullptr) {
+                std::copy_n(bits_.data() + i * stride_, stride_, bits.data() + mapping[i].index() * stride_);
+            }
+        }
+        bits_.swap(bits);
+        rows_ = rows;
+    }
+
+private:
+
+    static inline word_type mask(uint32_t bit) {
+        return word_type{1u} << (bit & (word_bits - 1u));
+    }
+
+    // grow rows and row width
+    void ensure(IndexType index, uint32_t bit) {
+        const size_t stride = (bit >> 6u) + 1u;
+        if (stride > stride_) {
+            std::pmr::vector<word_type> bits(rows_ * stride, 0u, bits_.get_allocator());
+            for (size_t i = 0u; i != rows_; ++i) {
+                std::copy_n(bits_.data() + i * stride_, stride_, bits.data() + i * stride);
+            }
+            bits_.swap(bits);
+            stride_ = stride;
+        }
+        if (index >= rows_) {
+            rows_ = std::max(static_cast<size_t>(index) + 1u, rows_ * 2u);
+            bits_.resize(rows_ * stride_);
+        }
+    }
+
+    std::pmr::vector<word_type> bits_;
+    size_t stride_ = 0u;
+    size_t rows_ = 0u;
+};
+
+}
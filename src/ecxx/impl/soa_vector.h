@@ -0,0 +1,263 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cassert>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <memory_resource>
+
+namespace ecxx {
+
+/**
+ * list of data members stored in separate arrays, required to cover all members of component, for example:
+ * using soa_layout = ecxx::soa_fields<&position::x, &position::y>;
+ **/
+template<auto ...Fields>
+struct soa_fields {
+    static constexpr size_t size = sizeof...(Fields);
+};
+
+template<typename MemberPointer>
+struct member_pointer_traits;
+
+template<typename Class, typename Field>
+struct member_pointer_traits<Field Class::*> {
+    using class_type = Class;
+    using field_type = Field;
+};
+
+template<auto Field>
+using field_type_t = typename member_pointer_traits<decltype(Field)>::field_type;
+
+template<auto Field>
+using field_class_t = typename member_pointer_traits<decltype(Field)>::class_type;
+
+// contiguous range of single field values
+template<typename T>
+class field_span {
+public:
+    field_span(T* data, size_t size) : data_{data}, size_{size} {
+    }
+
+    inline T* data() const {
+        return data_;
+    }
+
+    inline size_t size() const {
+        return size_;
+    }
+
+    inline T* begin() const {
+        return data_;
+    }
+
+    inline T* end() const {
+        return data_ + size_;
+    }
+
+    inline T& operator[](size_t i) const {
+        assert(i < size_);
+        return data_[i];
+    }
+
+private:
+    T* data_;
+    size_t size_;
+};
+
+/**
+ * structure-of-arrays storage: each field of T is kept in its own array,
+ * element 1 of every array is aligned to `field_alignment`,
+ * so dense ranges starting after null element are ready for SIMD loads.
+ * Fields are required to be trivially copyable
+ **/
+template<typename T, auto ...Fields>
+class soa_vector {
+public:
+    static constexpr size_t field_alignment = 64u;
+    static constexpr size_t fields_num = sizeof...(Fields);
+
+    static_assert(fields_num != 0u, "SoA layout requires at least one field");
+    static_assert((std::is_same_v<field_class_t<Fields>, T> && ...), "SoA fields must be members of T");
+    static_assert((std::is_trivially_copyable_v<field_type_t<Fields>> && ...), "SoA fields must be trivially copyable");
+    static_assert(((sizeof(field_type_t<Fields>) <= field_alignment) && ...), "SoA field is too large");
+    // members missing in layout would be lost on store, padding could not be told apart from them
+    static_assert((sizeof(field_type_t<Fields>) + ...) == sizeof(T),
+                  "SoA layout must list every member of T, components with padding are not supported");
+
+    using value_type = T;
+
+    explicit soa_vector(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : resource_{resource} {
+    }
+
+    soa_vector(const soa_vector&) = delete;
+
+    soa_vector& operator=(const soa_vector&) = delete;
+
+    ~soa_vector() {
+        deallocate(arrays_, capacity_, std::index_sequence_for<decltype(Fields)...>{});
+    }
+
+    template<typename ...Args>
+    void emplace_back(Args&& ...args) {
+        if (size_ == capacity_) {
+            reserve(capacity_ != 0u ? capacity_ * 2u : 8u);
+        }
+        if constexpr (std::is_aggregate_v<T>) {
+            set(size_++, T{std::forward<Args>(args)...});
+        } else {
+            set(size_++, T(std::forward<Args>(args)...));
+        }
+    }
+
+    void pop_back() {
+        assert(size_ != 0u);
+        --size_;
+    }
+
+    // gather all fields of element `i`
+    T get(size_t i) const {
+        assert(i < size_);
+        T value{};
+        get(i, value, std::index_sequence_for<decltype(Fields)...>{});
+        return value;
+    }
+
+    // scatter all fields of `value` to element `i`
+    void set(size_t i, const T& value) {
+        set(i, value, std::index_sequence_for<decltype(Fields)...>{});
+    }
+
+    void move(size_t to, size_t from) {
+        move(to, from, std::index_sequence_for<decltype(Fields)...>{});
+    }
+
+    void swap(size_t i, size_t j) {
+        swap(i, j, std::index_sequence_for<decltype(Fields)...>{});
+    }
+
+    template<auto Field>
+    inline field_type_t<Field>* data() const {
+        constexpr size_t index = index_of<Field>();
+        static_assert(index != fields_num, "field is not in SoA layout");
+        return std::get<index>(arrays_);
+    }
+
+    template<auto Field>
+    inline field_type_t<Field>& field(size_t i) const {
+        assert(i < size_);
+        return data<Field>()[i];
+    }
+
+    void reserve(size_t capacity) {
+        if (capacity > capacity_) {
+            arrays_type arrays{};
+            allocate(arrays, capacity, std::index_sequence_for<decltype(Fields)...>{});
+            copy(arrays, std::index_sequence_for<decltype(Fields)...>{});
+            deallocate(arrays_, capacity_, std::index_sequence_for<decltype(Fields)...>{});
+            arrays_ = arrays;
+            capacity_ = capacity;
+        }
+    }
+
+    inline size_t size() const {
+        return size_;
+    }
+
+    inline size_t capacity() const {
+        return capacity_;
+    }
+
+    inline std::pmr::memory_resource* resource() const {
+        return resource_;
+    }
+
+private:
+    using arrays_type = std::tuple<field_type_t<Fields>* ...>;
+
+    template<auto Field>
+    static constexpr size_t index_of() {
+        size_t index = fields_num;
+        size_t i = 0u;
+        ((index = same_field<Fields, Field>() ? i : index, ++i), ...);
+        return index;
+    }
+
+    template<auto A, auto B>
+    static constexpr bool same_field() {
+        if constexpr (std::is_same_v<decltype(A), decltype(B)>) {
+            return A == B;
+        } else {
+            return false;
+        }
+    }
+
+    // array begins `field_alignment - sizeof(F)` bytes into aligned block, so element 1 is aligned
+    template<typename F>
+    static constexpr size_t block_size(size_t capacity) {
+        return field_alignment - sizeof(F) + capacity * sizeof(F);
+    }
+
+    template<size_t ...I>
+    void allocate(arrays_type& arrays, size_t capacity, std::index_sequence<I...>) {
+        ((std::get<I>(arrays) = reinterpret_cast<field_type_t<Fields>*>(
+                static_cast<uint8_t*>(resource_->allocate(block_size<field_type_t<Fields>>(capacity),
+                                                          field_alignment))
+                + field_alignment - sizeof(field_type_t<Fields>))), ...);
+    }
+
+    template<size_t ...I>
+    void deallocate(arrays_type& arrays, size_t capacity, std::index_sequence<I...>) {
+        if (capacity != 0u) {
+            ((resource_->deallocate(reinterpret_cast<uint8_t*>(std::get<I>(arrays))
+                                    - (field_alignment - sizeof(field_type_t<Fields>)),
+                                    block_size<field_type_t<Fields>>(capacity), field_alignment)), ...);
+        }
+    }
+
+    template<size_t ...I>
+    void copy(arrays_type& arrays, std::index_sequence<I...>) {
+        if (size_ != 0u) {
+            ((std::memcpy(std::get<I>(arrays), std::get<I>(arrays_), size_ * sizeof(field_type_t<Fields>))), ...);
+        }
+    }
+
+    template<size_t ...I>
+    void get(size_t i, T& value, std::index_sequence<I...>) const {
+        ((value.*Fields = std::get<I>(arrays_)[i]), ...);
+    }
+
+    template<size_t ...I>
+    void set(size_t i, const T& value, std::index_sequence<I...>) {
+        ((std::get<I>(arrays_)[i] = value.*Fields), ...);
+    }
+
+    template<size_t ...I>
+    void move(size_t to, size_t from, std::index_sequence<I...>) {
+        ((std::get<I>(arrays_)[to] = std::get<I>(arrays_)[from]), ...);
+    }
+
+    template<size_t ...I>
+    void swap(size_t i, size_t j, std::index_sequence<I...>) {
+        (std::swap(std::get<I>(arrays_)[i], std::get<I>(arrays_)[j]), ...);
+    }
+
+    std::pmr::memory_resource* resource_;
+    arrays_type arrays_{};
+    size_t size_ = 0u;
+    size_t capacity_ = 0u;
+};
+
+template<typename T, typename Layout>
+struct soa_vector_for;
+
+template<typename T, auto ...Fields>
+struct soa_vector_for<T, soa_fields<Fields...>> {
+    using type = soa_vector<T, Fields...>;
+};
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace ecxx {
+
+// full sort, O(N log N) for any order
+struct std_sort {
+    template<typename It, typename Compare>
+    void operator()(It first, It last, Compare compare) const {
+        std::sort(first, last, compare);
+    }
+};
+
+// O(N) for nearly sorted ranges, for example when sort keys change a little between frames
+struct insertion_sort {
+    template<typename It, typename Compare>
+    void operator()(It first, It last, Compare compare) const {
+        if (first == last) {
+            return;
+        }
+        for (auto it = std::next(first); it != last; ++it) {
+            auto value = std::move(*it);
+            auto pos = it;
+            while (pos != first) {
+                auto prev = std::prev(pos);
+                if (!compare(value, *prev)) {
+                    break;
+                }
+                *pos = std::move(*prev);
+                pos = prev;
+            }
+            *pos = std::move(value);
+        }
+    }
+};
+
+}
@@ -1,39 +1,167 @@
 #pragma once
 
 #include <cstdint>
+#include <cassert>
 #include <memory>
+#include <array>
+#include <vector>
 #include <algorithm>
+#include <memory_resource>
 #include "bit_count.h"
 
 namespace ecxx {
 
-template<typename T, const T NullValue = T(), const uint32_t PageSize = 0x8000u>
+// page offset is 16-bit
+constexpr uint32_t sparse_max_page_elements = 0x10000u;
+
+// default capacity: index range of 32-bit entities
+constexpr uint64_t sparse_default_capacity = uint64_t{1u} << 20u;
+
+// page table of up to this number of pages is sized up front, larger tables grow on insert
+constexpr size_t sparse_eager_pages = 256u;
+
+/**
+ * cache of empty sparse pages shared between sparse vectors of the same kind,
+ * pages are bucketed by size,
+ * released pages are always filled with NullValue, so they are reused without fill
+ **/
+template<typename T, const T NullValue>
+class sparse_page_pool {
+public:
+    static constexpr uint32_t buckets_num = bit_count(sparse_max_page_elements - 1u) + 1u;
+
+    explicit sparse_page_pool(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : resource_{resource},
+              free_(buckets_num, resource) {
+    }
+
+    sparse_page_pool(const sparse_page_pool&) = delete;
+
+    sparse_page_pool& operator=(const sparse_page_pool&) = delete;
+
+    ~sparse_page_pool() {
+        trim(0u);
+    }
+
+    T* acquire(uint32_t page_bits) {
+        auto& bucket = free_[page_bits];
+        if (!bucket.empty()) {
+            T* page = bucket.back();
+            bucket.pop_back();
+            return page;
+        }
+        return allocate_page(resource_, 1u << page_bits);
+    }
+
+    // page is required to be filled with NullValue
+    void release(T* page, uint32_t page_bits) {
+        auto& bucket = free_[page_bits];
+        if (bucket.size() < high_water_) {
+            bucket.push_back(page);
+        } else {
+            deallocate_page(resource_, page, 1u << page_bits);
+        }
+    }
+
+    // limit number of cached free pages of each size, surplus is freed right away
+    void high_water(size_t pages) {
+        high_water_ = pages;
+        trim(pages);
+    }
+
+    void trim(size_t keep) {
+        for (uint32_t page_bits = 0u; page_bits != buckets_num; ++page_bits) {
+            auto& bucket = free_[page_bits];
+            while (bucket.size() > keep) {
+                deallocate_page(resource_, bucket.back(), 1u << page_bits);
+                bucket.pop_back();
+            }
+        }
+    }
+
+    inline size_t free_pages() const {
+        size_t count = 0u;
+        for (const auto& bucket : free_) {
+            count += bucket.size();
+        }
+        return count;
+    }
+
+    inline std::pmr::memory_resource* resource() const {
+        return resource_;
+    }
+
+    static T* allocate_page(std::pmr::memory_resource* resource, uint32_t elements) {
+        T* page = static_cast<T*>(resource->allocate(sizeof(T) * elements, alignof(T)));
+        std::uninitialized_fill_n(page, elements, NullValue);
+        return page;
+    }
+
+    static void deallocate_page(std::pmr::memory_resource* resource, T* page, uint32_t elements) {
+        resource->deallocate(page, sizeof(T) * elements, alignof(T));
+    }
+
+private:
+    std::pmr::memory_resource* resource_;
+    // inner vectors get the same resource by uses-allocator construction
+    std::pmr::vector<std::pmr::vector<T*>> free_;
+    size_t high_water_ = ~size_t{0u};
+};
+
+/**
+ * unallocated pages point to shared read-only null page, so lookup is two loads and bounds check.
+ * Page table covering whole Capacity is sized up front if it has up to `sparse_eager_pages` entries,
+ * otherwise (wide index range or small pages) it grows on insert up to the last used page.
+ * PageSize is default page size in bytes, could be overridden on construction
+ **/
+template<typename T, const T NullValue = T(), const uint32_t PageSize = 0x8000u, typename SizeType = uint32_t,
+        const uint64_t Capacity = sparse_default_capacity>
 class sparse_vector {
 public:
-    // PageSize required to be power-of-two value
-    static_assert(PageSize > 0u && ((PageSize & (PageSize - 1u)) == 0u));
 
-    using size_type = uint32_t;
+    using size_type = SizeType;
     using page_offset_type = uint16_t;
-    using page_index_type = uint16_t;
+    using page_index_type = SizeType;
 
-    static constexpr uint32_t elements_per_page = PageSize / sizeof(T);
-    static constexpr uint32_t page_mask = elements_per_page - 1u;
-    static constexpr uint32_t page_bits = bit_count(page_mask);
+    using page_pool_type = sparse_page_pool<T, NullValue>;
 
-    struct page_data {
-        std::unique_ptr<T[]> elements;
-        size_type count{0u};
-    };
+    /**
+     * page_size - page size in bytes, required to be power-of-two value
+     * empty pages are returned to `page_pool` if provided, otherwise they are freed
+     * pages and page table are allocated from `resource` or from page pool resource
+     **/
+    explicit sparse_vector(page_pool_type* page_pool = nullptr, uint32_t page_size = PageSize,
+                           std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : page_bits_{bit_count(page_size / sizeof(T) - 1u)},
+              page_mask_{page_size / static_cast<uint32_t>(sizeof(T)) - 1u},
+              pages_(max_pages() <= sparse_eager_pages ? max_pages() : 0u, null_page(),
+                     page_pool != nullptr ? page_pool->resource() : resource),
+              counts_(pages_.size(), 0u, pages_.get_allocator()),
+              page_pool_{page_pool} {
+        assert(page_size >= sizeof(T) && (page_size & (page_size - 1u)) == 0u);
+        assert(page_size / sizeof(T) <= sparse_max_page_elements);
+    }
+
+    sparse_vector(const sparse_vector&) = delete;
+
+    sparse_vector& operator=(const sparse_vector&) = delete;
+
+    ~sparse_vector() {
+        clear();
+    }
 
     void ensure(page_index_type page) {
+        assert(page < max_pages());
         if (page >= pages_.size()) {
-            pages_.resize(page + 1);
+            pages_.resize(static_cast<size_t>(page) + 1u, null_page());
+            counts_.resize(pages_.size(), 0u);
         }
-
-        if (!pages_[page].elements) {
-            pages_[page].elements = std::make_unique<T[]>(elements_per_page);
-            std::fill_n(pages_[page].elements.get(), elements_per_page, NullValue);
+        if (pages_[page] == null_page()) {
+            if (page_pool_ != nullptr) {
+                pages_[page] = page_pool_->acquire(page_bits_);
+            } else {
+                pages_[page] = page_pool_type::allocate_page(resource(), elements_per_page());
+            }
         }
     }
 
@@ -41,84 +169,131 @@ public:
         assert(v != NullValue);
         assert(!has(i));
 
-        page_index_type pi = i >> page_bits;
-        page_offset_type po = i & page_mask;
+        page_index_type pi = i >> page_bits_;
+        page_offset_type po = i & page_mask_;
 
         ensure(pi);
-        pages_[pi].elements[po] = v;
-        pages_[pi].count++;
+        pages_[pi][po] = v;
+        counts_[pi]++;
     }
 
     void replace(size_type i, T v) {
         assert(v != NullValue);
         assert(has(i));
 
-        page_index_type pi = i >> page_bits;
-        page_offset_type po = i & page_mask;
-        pages_[pi].elements[po] = v;
-    }
-
-    // unsafe just write element to map
-//    void set(size_type i, T v) {
-//        page_index_type pi = i >> page_bits;
-//        page_offset_type po = i & page_mask;
-//
-//        ensure(pi);
-//        pages_[pi].elements[po] = v;
-//        pages_[pi].count++;
-//    }
-
-    T at(size_type i) const {
-        const page_index_type page = i >> page_bits;
-        const page_offset_type offset = i & page_mask;
-        T el{NullValue};
-        if (page < pages_.size()) {
-            const page_data& p = pages_[page];
-            if (p.count) {
-                el = p.elements[offset];
-            }
-        }
-        return el;
+        page_index_type pi = i >> page_bits_;
+        page_offset_type po = i & page_mask_;
+        pages_[pi][po] = v;
+    }
+
+    inline T at(size_type i) const {
+        const size_t page = i >> page_bits_;
+        return page < pages_.size() ? pages_[page][i & page_mask_] : NullValue;
     }
 
     void remove(size_type i) {
-        const page_index_type page = i >> page_bits;
-        const page_offset_type offset = i & page_mask;
+        const page_index_type page = i >> page_bits_;
+        const page_offset_type offset = i & page_mask_;
         assert(has(page, offset));
-        page_data& p = pages_[page];
-        p.elements[offset] = NullValue;
-        --p.count;
+        pages_[page][offset] = NullValue;
+        if (--counts_[page] == 0u) {
+            release(page);
+        }
     }
 
     T get_and_remove(size_type i) {
-        const page_index_type page = i >> page_bits;
-        const page_offset_type offset = i & page_mask;
+        const page_index_type page = i >> page_bits_;
+        const page_offset_type offset = i & page_mask_;
         assert(has(page, offset));
-        page_data& p = pages_[page];
-        auto v = p.elements[offset];
-        p.elements[offset] = NullValue;
-        --p.count;
+        auto v = pages_[page][offset];
+        pages_[page][offset] = NullValue;
+        if (--counts_[page] == 0u) {
+            release(page);
+        }
         return v;
     }
 
     inline bool has(size_type i) const {
-        const page_index_type page = i >> page_bits;
-        const page_offset_type offset = i & page_mask;
-        return has(page, offset);
+        return at(i) != NullValue;
     }
 
     inline bool has(page_index_type i, page_offset_type j) const {
-        if (i < pages_.size()) {
-            const page_data& p = pages_[i];
-            return p.count && p.elements[j] != NullValue;
-        } else {
-            return false;
+        return i < pages_.size() && pages_[i][j] != NullValue;
+    }
+
+    // release all pages
+    void clear() {
+        for (size_t page = 0u; page != pages_.size(); ++page) {
+            if (pages_[page] != null_page()) {
+                // pooled pages are required to be empty
+                if (counts_[page] != 0u && page_pool_ != nullptr) {
+                    std::fill_n(pages_[page], elements_per_page(), NullValue);
+                }
+                counts_[page] = 0u;
+                release(static_cast<page_index_type>(page));
+            }
         }
     }
 
+    inline size_type pages_allocated() const {
+        size_type count{0u};
+        for (auto* page : pages_) {
+            count += page != null_page() ? 1u : 0u;
+        }
+        return count;
+    }
+
+    inline uint32_t elements_per_page() const {
+        return page_mask_ + 1u;
+    }
+
+    // number of pages covering whole Capacity
+    inline size_t max_pages() const {
+        return static_cast<size_t>((Capacity + page_mask_) >> page_bits_);
+    }
+
+    // current size of page table
+    inline size_t table_size() const {
+        return pages_.size();
+    }
+
 private:
 
-    std::vector<page_data> pages_;
+    // null page is never written: all writes go to ensured pages
+    static T* null_page() {
+        if constexpr (NullValue == T{}) {
+            // zero-initialized, untouched pages stay shared zero pages of OS
+            static std::array<T, sparse_max_page_elements> page{};
+            return page.data();
+        } else {
+            static std::array<T, sparse_max_page_elements> page = [] {
+                std::array<T, sparse_max_page_elements> elements{};
+                elements.fill(NullValue);
+                return elements;
+            }();
+            return page.data();
+        }
+    }
+
+    void release(page_index_type page) {
+        if (page_pool_ != nullptr) {
+            page_pool_->release(pages_[page], page_bits_);
+        } else {
+            page_pool_type::deallocate_page(resource(), pages_[page], elements_per_page());
+        }
+        pages_[page] = null_page();
+    }
+
+    inline std::pmr::memory_resource* resource() const {
+        return pages_.get_allocator().resource();
+    }
+
+    uint32_t page_bits_;
+    uint32_t page_mask_;
+    std::pmr::vector<T*> pages_;
+    // number of non-null elements per page
+    std::pmr::vector<size_type> counts_;
+    page_pool_type* page_pool_ = nullptr;
 };
 
-}
\ No newline at end of file
+}
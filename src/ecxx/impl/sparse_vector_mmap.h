@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cassert>
+#include <algorithm>
+#include <memory_resource>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <sys/mman.h>
+
+#define ECXX_HAS_MMAP 1
+#endif
+
+namespace ecxx {
+
+// there are no pages to share in mmap mode
+struct sparse_null_page_pool {
+    explicit sparse_null_page_pool(std::pmr::memory_resource* = nullptr) {}
+
+    inline void high_water(size_t) {}
+
+    inline void trim(size_t) {}
+
+    inline size_t free_pages() const {
+        return 0u;
+    }
+};
+
+/**
+ * sparse vector with zero null value reserving address space for whole Capacity range,
+ * OS supplies zero pages on first touch, so there is no page table and no page fill.
+ * falls back to `calloc` if anonymous mmap is not available
+ **/
+template<typename T, const uint64_t Capacity, typename SizeType = uint32_t>
+class sparse_vector_mmap {
+public:
+    static_assert(Capacity > 0u);
+
+    using size_type = SizeType;
+
+    static constexpr size_t reserved_bytes = static_cast<size_t>(Capacity) * sizeof(T);
+
+    using page_pool_type = sparse_null_page_pool;
+
+    // there are no pages, so page pool, page size and memory resource are ignored
+    explicit sparse_vector_mmap(page_pool_type* = nullptr, uint32_t = 0u, std::pmr::memory_resource* = nullptr) {
+#ifdef ECXX_HAS_MMAP
+        elements_ = map(nullptr, 0);
+#else
+        elements_ = static_cast<T*>(std::calloc(static_cast<size_t>(Capacity), sizeof(T)));
+        if (elements_ == nullptr) {
+            std::abort();
+        }
+#endif
+    }
+
+    sparse_vector_mmap(const sparse_vector_mmap&) = delete;
+
+    sparse_vector_mmap& operator=(const sparse_vector_mmap&) = delete;
+
+    ~sparse_vector_mmap() {
+#ifdef ECXX_HAS_MMAP
+        munmap(elements_, reserved_bytes);
+#else
+        std::free(elements_);
+#endif
+    }
+
+    void insert(size_type i, T v) {
+        assert(v != T{});
+        assert(!has(i));
+        elements_[i] = v;
+    }
+
+    void replace(size_type i, T v) {
+        assert(v != T{});
+        assert(has(i));
+        elements_[i] = v;
+    }
+
+    inline T at(size_type i) const {
+        assert(i < Capacity);
+        return elements_[i];
+    }
+
+    void remove(size_type i) {
+        assert(has(i));
+        elements_[i] = T{};
+    }
+
+    T get_and_remove(size_type i) {
+        assert(has(i));
+        const T v = elements_[i];
+        elements_[i] = T{};
+        return v;
+    }
+
+    inline bool has(size_type i) const {
+        assert(i < Capacity);
+        return elements_[i] != T{};
+    }
+
+    // return touched pages back to OS, range stays reserved
+    void clear() {
+#ifdef ECXX_HAS_MMAP
+        // map fresh zero pages over the same range
+        map(elements_, MAP_FIXED);
+#else
+        std::fill_n(elements_, static_cast<size_t>(Capacity), T{});
+#endif
+    }
+
+private:
+
+#ifdef ECXX_HAS_MMAP
+    static T* map(void* address, int flags) {
+        void* ptr = mmap(address, reserved_bytes,
+                         PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | flags,
+                         -1, 0);
+        if (ptr == MAP_FAILED) {
+            std::abort();
+        }
+        return static_cast<T*>(ptr);
+    }
+#endif
+
+    T* elements_ = nullptr;
+};
+
+}
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include "entity_pool.h"
+#include "entity_map.h"
+#include "identity_generator.h"
+#include "view.h"
+#include "runtime_view.h"
+#include "rview.h"
+
+namespace ecxx {
+
+/**
+ * world with set of components known at compile-time:
+ * pools are stored in tuple, so every pool lookup is resolved at compile-time,
+ * destroy and views call pools directly without virtual dispatch.
+ * API matches `base_world` for listed components
+ **/
+template<typename EntityType, typename ...Components>
+class basic_static_world {
+public:
+    using entity_type = entity_value<EntityType>;
+    using entity_pool = basic_entity_pool<EntityType>;
+    using component_typeid = uint32_t;
+    using component_hash = uint64_t;
+    using map_base_type = entity_map_base<EntityType>;
+    using page_pool_type = typename map_base_type::page_pool_type;
+    using tick_type = typename map_base_type::tick_type;
+
+    template<typename Component>
+    using pool_type = entity_map<EntityType, Component>;
+
+    explicit basic_static_world(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : pool_{resource},
+              page_pool_{resource},
+              pools_{(static_cast<void>(sizeof(Components)), pool_args{&page_pool_, resource, &tick_})...} {
+    }
+
+    basic_static_world(const basic_static_world&) = delete;
+
+    inline void reserve(size_t size) {
+        pool_.reserve(size);
+    }
+
+    template<typename ...Component>
+    inline entity_type create() {
+        auto e = pool_.allocate();
+        (assign<Component>(e), ...);
+        return e;
+    }
+
+    template<typename ...Component, typename It>
+    void create(It begin, It end) {
+        pool_.allocate(begin, end);
+        (storage<Component>().insert(begin, end), ...);
+    }
+
+    inline void destroy(entity_type entity) {
+        (remove_if_has(std::get<stored<Components>>(pools_), entity), ...);
+        pool_.deallocate(entity);
+    }
+
+    template<typename It>
+    void destroy(It begin, It end) {
+        if (begin != end) {
+            (remove_all(std::get<stored<Components>>(pools_), begin, end), ...);
+            pool_.deallocate(begin, end);
+        }
+    }
+
+    // see `base_world::compact`
+    std::vector<entity_type> compact() {
+        auto remap = pool_.compact();
+        (std::get<stored<Components>>(pools_).remap(remap), ...);
+        return remap;
+    }
+
+    template<typename Func>
+    inline void each(Func func) const {
+        pool_.each(func);
+    }
+
+    template<typename Component, typename ...Args>
+    inline decltype(auto) assign(entity_type entity, Args&& ... args) {
+        return storage<Component>().emplace(entity, std::forward<Args>(args)...);
+    }
+
+    template<typename Component, typename It,
+            typename = std::enable_if_t<!std::is_convertible_v<It, entity_type>>>
+    inline void assign(It begin, It end) {
+        storage<Component>().insert(begin, end);
+    }
+
+    template<typename Component, typename It,
+            typename = std::enable_if_t<!std::is_convertible_v<It, entity_type>>>
+    inline void assign(It begin, It end, const Component& value) {
+        storage<Component>().insert(begin, end, value);
+    }
+
+    template<typename Component, typename It>
+    inline void replace(It begin, It end, const Component& value) {
+        storage<Component>().replace(begin, end, value);
+    }
+
+    template<typename Component, typename ...Args>
+    inline decltype(auto) replace_or_assign(entity_type entity, Args&& ... args) {
+        auto& pool = storage<Component>();
+        if (pool.has(entity)) {
+            return pool.replace(entity, std::forward<Args>(args)...);
+        }
+        return pool.emplace(entity, std::forward<Args>(args)...);
+    }
+
+    template<typename Component>
+    inline auto& on_construct() {
+        return storage<Component>().on_construct();
+    }
+
+    template<typename Component>
+    inline auto& on_destroy() {
+        return storage<Component>().on_destroy();
+    }
+
+    template<typename Component>
+    inline auto& on_update() {
+        return storage<Component>().on_update();
+    }
+
+    template<typename Component>
+    inline bool has(entity_type entity) const {
+        return storage<Component>().has(entity);
+    }
+
+    template<typename Component>
+    inline decltype(auto) get(entity_type entity) const {
+        return storage<Component>().get(entity);
+    }
+
+    template<typename Component>
+    inline decltype(auto) get(entity_type entity) {
+        return storage<Component>().get(entity);
+    }
+
+    template<typename Component>
+    inline decltype(auto) get_or_create(entity_type entity) {
+        return storage<Component>().get_or_create(entity);
+    }
+
+    template<typename Component>
+    inline decltype(auto) get_or_default(entity_type entity) const {
+        return storage<Component>().get_or_default(entity);
+    }
+
+    template<typename Component, typename Compare, typename Sort = std_sort>
+    inline void sort(Compare compare, Sort algorithm = Sort{}) {
+        storage<Component>().sort(compare, algorithm);
+    }
+
+    template<typename ...Component>
+    inline void pack() {
+        (storage<Component>().pack(), ...);
+    }
+
+    template<typename Component, typename Other>
+    inline void respect() {
+        storage<Component>().respect(storage<Other>());
+    }
+
+    template<auto Field>
+    inline auto& field(entity_type entity) {
+        return storage<field_class_t<Field>>().template field<Field>(entity);
+    }
+
+    template<auto Field>
+    inline auto span() {
+        return storage<field_class_t<Field>>().template span<Field>();
+    }
+
+    template<typename Component>
+    inline void remove(entity_type entity) {
+        storage<Component>().erase(entity);
+    }
+
+    template<typename Component, typename It>
+    inline void remove(It begin, It end) {
+        storage<Component>().erase(begin, end);
+    }
+
+    template<typename ...Component, typename ...Excluded>
+    inline auto view(exclude_t<Excluded...> = {}) {
+        return filtered_view<EntityType, exclude_t<Excluded...>, Component...>{storage<Excluded>()...,
+                                                                               storage<Component>()...};
+    }
+
+    template<typename ...Component>
+    inline auto rview() {
+        return basic_rview<EntityType, Component...>{storage<Component>()...};
+    }
+
+    // components are selected by `type()`, unknown types are skipped like unused ones in `base_world`
+    template<typename It>
+    inline runtime_view_t<EntityType> runtime_view(It begin, It end) {
+        return runtime_view(begin, end, end, end);
+    }
+
+    template<typename It, typename ExcludeIt>
+    inline runtime_view_t<EntityType> runtime_view(It begin, It end, ExcludeIt exclude_begin, ExcludeIt exclude_end) {
+        std::vector<map_base_type*> table;
+        for (auto it = begin; it != end; ++it) {
+            map_base_type* set = find(*it);
+            if (set != nullptr) {
+                table.emplace_back(set);
+            }
+        }
+        std::vector<const map_base_type*> excluded;
+        for (auto it = exclude_begin; it != exclude_end; ++it) {
+            const map_base_type* set = find(*it);
+            if (set != nullptr) {
+                excluded.emplace_back(set);
+            }
+        }
+        return runtime_view_t(table, excluded);
+    }
+
+    inline tick_type tick() const {
+        return tick_;
+    }
+
+    inline void advance_tick() {
+        ++tick_;
+    }
+
+    inline auto& page_pool() {
+        return page_pool_;
+    }
+
+    inline const auto& pool() const {
+        return pool_;
+    }
+
+    inline auto& pool() {
+        return pool_;
+    }
+
+    template<typename Component>
+    inline component_typeid type() noexcept {
+        return identity_generator<Component, component_typeid>::value;
+    }
+
+    template<typename Component>
+    constexpr inline component_hash hash() noexcept {
+        return type_hash<Component>();
+    }
+
+    inline map_base_type* components(component_hash hash) {
+        map_base_type* set = nullptr;
+        ((set = hash == type_hash<Components>() ? &storage<Components>() : set), ...);
+        return set;
+    }
+
+    // pool of listed component
+    template<typename Component>
+    inline pool_type<Component>& storage() {
+        static_assert((std::is_same_v<Component, Components> || ...), "component is not in static world");
+        return std::get<stored<Component>>(pools_);
+    }
+
+    template<typename Component>
+    inline const pool_type<Component>& storage() const {
+        static_assert((std::is_same_v<Component, Components> || ...), "component is not in static world");
+        return std::get<stored<Component>>(pools_);
+    }
+
+    inline bool valid(entity_type entity) const {
+        return pool_.valid(entity);
+    }
+
+    template<typename It, typename Out>
+    inline Out valid(It begin, It end, Out out) const {
+        return pool_.valid(begin, end, out);
+    }
+
+private:
+
+    struct pool_args {
+        page_pool_type* page_pool;
+        std::pmr::memory_resource* resource;
+        const tick_type* clock;
+    };
+
+    // tuple element constructed from single argument
+    template<typename Component>
+    struct stored : pool_type<Component> {
+        explicit stored(const pool_args& args)
+                : pool_type<Component>{args.page_pool, args.resource, args.clock} {
+        }
+    };
+
+    inline map_base_type* find(component_typeid type) {
+        map_base_type* set = nullptr;
+        ((set = type == this->type<Components>() ? &storage<Components>() : set), ...);
+        return set;
+    }
+
+    template<typename Pool>
+    static inline void remove_if_has(Pool& pool, entity_type entity) {
+        if (pool.has(entity)) {
+            pool.erase(entity);
+        }
+    }
+
+    template<typename Pool, typename It>
+    static inline void remove_all(Pool& pool, It begin, It end) {
+        if (pool.size() != 0u) {
+            pool.erase(begin, end);
+        }
+    }
+
+    entity_pool pool_;
+    // declared before pools to outlive them
+    page_pool_type page_pool_;
+    // starts after 0, so `changed_since(0)` reports all components
+    tick_type tick_ = 1u;
+    std::tuple<stored<Components>...> pools_;
+};
+
+template<typename ...Components>
+using static_world = basic_static_world<uint32_t, Components...>;
+
+}
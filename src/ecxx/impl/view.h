@@ -1,35 +1,98 @@
 #pragma once
 
 #include <array>
+#include <tuple>
+#include <utility>
+#include <type_traits>
 
 #include "components_db.h"
 
 namespace ecxx {
 
-template<typename T, typename ...Component>
-class basic_view {
+// components entities of view must not have: `world.view<A, B>(exclude<C, D>)`
+template<typename ...Component>
+struct exclude_t {
+};
+
+template<typename ...Component>
+inline constexpr exclude_t<Component...> exclude{};
+
+namespace details {
+
+// parameters of callback with non-template call operator, unknown for generic lambdas
+template<typename Func, typename = void>
+struct callback_params {
+    static constexpr bool known = false;
+};
+
+template<typename R, typename ...Args>
+struct callback_params<R(*)(Args...)> {
+    static constexpr bool known = true;
+    using type = std::tuple<Args...>;
+};
+
+template<typename C, typename R, typename ...Args>
+struct callback_params<R(C::*)(Args...)> : callback_params<R(*)(Args...)> {
+};
+
+template<typename C, typename R, typename ...Args>
+struct callback_params<R(C::*)(Args...) const> : callback_params<R(*)(Args...)> {
+};
+
+template<typename Func>
+struct callback_params<Func, std::void_t<decltype(&Func::operator())>>
+        : callback_params<decltype(&Func::operator())> {
+};
+
+// `I`-th argument could be written: it's taken by non-const reference, or parameters are unknown
+template<typename Func, size_t I>
+constexpr bool writes_param() {
+    if constexpr (callback_params<Func>::known) {
+        using param = std::tuple_element_t<I, typename callback_params<Func>::type>;
+        return std::is_lvalue_reference_v<param> && !std::is_const_v<std::remove_reference_t<param>>;
+    } else {
+        return true;
+    }
+}
+
+}
+
+template<typename T, typename Exclude, typename ...Component>
+class filtered_view;
+
+template<typename T, typename ...Excluded, typename ...Component>
+class filtered_view<T, exclude_t<Excluded...>, Component...> {
 public:
     using entity_type = entity_value<T>;
     using index_type = typename entity_type::index_type;
     static constexpr auto components_num = sizeof ... (Component);
+    static constexpr auto excluded_num = sizeof ... (Excluded);
     using map_type = entity_map_base<T>;
 
     using table_type = std::array<map_type*, components_num>;
+    using excluded_type = std::array<const map_type*, excluded_num>;
     using table_index_type = uint32_t;
 
     using indices_type = std::array<table_index_type, components_num>;
 
-    using entity_vector_iterator = typename std::vector<entity_type>::iterator;
+    using entity_vector_iterator = typename map_type::entity_vector_iterator;
+    using tick_type = typename map_type::tick_type;
 
-    class iterator {
+    // `Changed` iterator also skips entities not changed since tick, see `changed_since`
+    template<bool Changed>
+    class basic_iterator {
     public:
-        iterator(table_type& table, entity_vector_iterator it)
-                : table_{table},
-                  it_{it} {
+        basic_iterator(table_type& table, const excluded_type& excluded, entity_vector_iterator it,
+                       const map_type* changed = nullptr, tick_type since = 0u)
+                : it_{it},
+                  table_{table},
+                  excluded_{excluded},
+                  changed_{changed},
+                  since_{since} {
             skips();
         }
 
-        inline iterator& operator++() noexcept {
+        inline basic_iterator& operator++() noexcept {
             if (it_ != first_map().end() && *it_ == ent_) {
                 ++it_;
             }
@@ -37,11 +100,11 @@ public:
             return *this;
         }
 
-        inline bool operator==(const iterator& other) const {
+        inline bool operator==(const basic_iterator& other) const {
             return ent_ == other.ent_;
         }
 
-        inline bool operator!=(const iterator& other) const {
+        inline bool operator!=(const basic_iterator& other) const {
             return ent_ != other.ent_;
         }
 
@@ -54,11 +117,23 @@ public:
         }
 
         inline bool valid(entity_type entity) const {
+            // skip tombstones of first map
+            if (entity == nullptr) {
+                return false;
+            }
             for (uint32_t i = 1u; i < components_num; ++i) {
                 if (!table_[i]->has(entity)) {
                     return false;
                 }
             }
+            for (uint32_t i = 0u; i < excluded_num; ++i) {
+                if (excluded_[i]->has(entity)) {
+                    return false;
+                }
+            }
+            if constexpr (Changed) {
+                return changed_->changed_since(entity, since_);
+            }
             return true;
         }
 
@@ -78,11 +153,52 @@ public:
         entity_vector_iterator it_;
         entity_type ent_;
         table_type& table_;
+        const excluded_type& excluded_;
+        const map_type* changed_;
+        tick_type since_;
+    };
+
+    using iterator = basic_iterator<false>;
+
+    // view filtered by changes of single component
+    class changed_view {
+    public:
+        using iterator = basic_iterator<true>;
+
+        changed_view(const filtered_view& view, const map_type* changed, tick_type since)
+                : view_{view},
+                  changed_{changed},
+                  since_{since} {
+        }
+
+        iterator begin() {
+            return {view_.table_, view_.excluded_, view_.table_[0]->begin(), changed_, since_};
+        }
+
+        iterator end() {
+            return {view_.table_, view_.excluded_, view_.table_[0]->end(), changed_, since_};
+        }
+
+        template<typename Func>
+        void each(Func func) {
+            view_.each(*this, func, std::index_sequence_for<Component...>{});
+        }
+
+    private:
+        filtered_view view_;
+        const map_type* changed_;
+        tick_type since_;
     };
 
-    explicit basic_view(components_db <T>& db) {
+    explicit filtered_view(components_db <T>& db)
+            : filtered_view{db.template ensure<Excluded>()..., db.template ensure<Component>()...} {
+    }
+
+    // pools are known at compile-time, see `static_world`
+    explicit filtered_view(const entity_map <T, Excluded>& ...excluded, entity_map <T, Component>& ...pools)
+            : excluded_{&excluded...} {
         table_index_type i{};
-        ((access_[i] = table_[i] = &db.template ensure<Component>(), ++i), ...);
+        ((access_[i] = table_[i] = &pools, ++i), ...);
 
         std::sort(table_.begin(), table_.end(), [this](auto a, auto b) -> bool {
             return a->size() < b->size();
@@ -90,29 +206,72 @@ public:
     }
 
     iterator begin() {
-        return {table_, table_[0]->begin()};
+        return {table_, excluded_, table_[0]->begin()};
     }
 
     iterator end() {
-        return {table_, table_[0]->end()};
+        return {table_, excluded_, table_[0]->end()};
     }
 
     template<typename Comp>
-    constexpr inline Comp& unsafe_get(table_index_type i, entity_type e) {
-        return static_cast<entity_map <T, Comp>*>(access_[i++])->get(e);
+    constexpr inline decltype(auto) unsafe_get(table_index_type i, entity_type e) {
+        return static_cast<entity_map <T, Comp>*>(access_[i])->get(e);
     }
 
+    /**
+     * func(Component&...), components taken by value or const reference are read without change stamp,
+     * generic lambda arguments are always stamped as written
+     **/
     template<typename Func>
     void each(Func func) {
-        for (auto e : *this) {
-            table_index_type i{0u};
-            func(unsafe_get<Component>(i++, e)...);
-        }
+        each(*this, func, std::index_sequence_for<Component...>{});
+    }
+
+    /**
+     * entities of view with `Comp` added or modified after `tick`,
+     * `Comp` is required to track changes, see `component_traits::track_changes`
+     **/
+    template<typename Comp>
+    changed_view changed_since(tick_type tick) const {
+        constexpr table_index_type index = index_of<Comp>();
+        static_assert(index != components_num, "component is not in view");
+        static_assert(component_traits<Comp>::track_changes, "component changes are not tracked");
+        return {*this, access_[index], tick};
     }
 
 private:
+
+    template<typename Comp>
+    static constexpr table_index_type index_of() {
+        table_index_type index = components_num;
+        table_index_type i = 0u;
+        ((index = std::is_same_v<Comp, Component> ? i : index, ++i), ...);
+        return index;
+    }
+
+    template<typename Comp, bool Write>
+    inline decltype(auto) get(table_index_type i, entity_type e) {
+        if constexpr (Write) {
+            return unsafe_get<Comp>(i, e);
+        } else {
+            return static_cast<const entity_map <T, Comp>*>(access_[i])->get(e);
+        }
+    }
+
+    template<typename Range, typename Func, size_t ...I>
+    inline void each(Range& range, Func& func, std::index_sequence<I...>) {
+        for (auto e : range) {
+            func(get<Component, details::writes_param<Func, I>()>(I, e)...);
+        }
+    }
+
     table_type access_;
+    // pivot is chosen only from included pools
     table_type table_;
+    excluded_type excluded_;
 };
 
+template<typename T, typename ...Component>
+using basic_view = filtered_view<T, exclude_t<>, Component...>;
+
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cstdint>
+#include <cassert>
+#include <utility>
+#include <type_traits>
 #include "entity_pool.h"
 #include "components_db.h"
 #include "entity_wrapper.h"
@@ -17,8 +20,16 @@ public:
     using entity_pool = basic_entity_pool<EntityType>;
     using component_typeid = uint32_t;
     using component_database = components_db<EntityType>;
+    using component_hash = typename component_database::component_hash;
+    using tick_type = typename component_database::tick_type;
 
-    base_world() = default;
+    /** all world storage is allocated from `resource`:
+        entity pool, component pools, sparse pages and dense arrays
+     **/
+    explicit base_world(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : pool_{resource},
+              components_{resource} {
+    }
 
     base_world(const base_world&) = delete;
 
@@ -36,11 +47,7 @@ public:
     template<typename ...Component, typename It>
     void create(It begin, It end) {
         pool_.allocate(begin, end);
-        if constexpr (sizeof...(Component) > 0) {
-            for (auto it = begin; it != end; ++it) {
-                (assign<Component>(*it), ...);
-            }
-        }
+        (components_.template ensure<Component>().insert(begin, end), ...);
     }
 
     inline void destroy(entity_type entity) {
@@ -48,26 +55,84 @@ public:
         pool_.deallocate(entity);
     }
 
+    /** destroy range of entities,
+        range is required to be contiguous (array, vector)
+     **/
+    template<typename It>
+    void destroy(It begin, It end) {
+        if (begin != end) {
+            const entity_type* first = &*begin;
+            components_.remove_all_c(first, first + std::distance(begin, end));
+            pool_.deallocate(begin, end);
+        }
+    }
+
+    /** renumber alive entities into dense low index range to shrink sparse tables,
+        returns remap table (old index -> new entity), entity handles are fixed by:
+        `e = remap[e.index()]` after checking `remap[e.index()].version() == e.version()`
+     **/
+    std::vector<entity_type> compact() {
+        auto remap = pool_.compact();
+        components_.remap(remap);
+        return remap;
+    }
+
     template<typename Func>
     inline void each(Func func) const {
         pool_.each(func);
     }
 
     template<typename Component, typename ...Args>
-    inline Component& assign(entity_type entity, Args&& ... args) {
+    inline decltype(auto) assign(entity_type entity, Args&& ... args) {
         auto& pool = components_.template ensure<Component>();
-        return pool.emplace(entity, args...);
+        return pool.emplace(entity, std::forward<Args>(args)...);
+    }
+
+    // assign default `Component` to range of entities without it
+    template<typename Component, typename It,
+            typename = std::enable_if_t<!std::is_convertible_v<It, entity_type>>>
+    inline void assign(It begin, It end) {
+        components_.template ensure<Component>().insert(begin, end);
+    }
+
+    // assign copies of `value` to range of entities without `Component`
+    template<typename Component, typename It,
+            typename = std::enable_if_t<!std::is_convertible_v<It, entity_type>>>
+    inline void assign(It begin, It end, const Component& value) {
+        components_.template ensure<Component>().insert(begin, end, value);
+    }
+
+    // replace `Component` of range of entities by copies of `value`
+    template<typename Component, typename It>
+    inline void replace(It begin, It end, const Component& value) {
+        auto* pool = components_.template try_get<Component>();
+        assert(pool);
+        pool->replace(begin, end, value);
     }
 
     template<typename Component, typename ...Args>
-    inline Component& replace_or_assign(entity_type entity, Args&& ... args) {
+    inline decltype(auto) replace_or_assign(entity_type entity, Args&& ... args) {
         auto& pool = components_.template ensure<Component>();
         if (pool.has(entity)) {
-            auto& data = pool.get(entity);
-            data = {args...};
-            return data;
+            return pool.replace(entity, std::forward<Args>(args)...);
         }
-        return pool.emplace(entity, args...);
+        return pool.emplace(entity, std::forward<Args>(args)...);
+    }
+
+    // see `entity_map_base::on_construct`
+    template<typename Component>
+    inline auto& on_construct() {
+        return components_.template ensure<Component>().on_construct();
+    }
+
+    template<typename Component>
+    inline auto& on_destroy() {
+        return components_.template ensure<Component>().on_destroy();
+    }
+
+    template<typename Component>
+    inline auto& on_update() {
+        return components_.template ensure<Component>().on_update();
     }
 
     template<typename Component>
@@ -77,31 +142,68 @@ public:
     }
 
     template<typename Component>
-    inline const Component& get(entity_type entity) const {
+    inline decltype(auto) get(entity_type entity) const {
         const auto* pool = components_.template try_get<Component>();
         assert(pool);
         return pool->get(entity);
     }
 
     template<typename Component>
-    inline Component& get(entity_type entity) {
+    inline decltype(auto) get(entity_type entity) {
         auto* pool = components_.template try_get<Component>();
         assert(pool);
         return pool->get(entity);
     }
 
     template<typename Component>
-    inline Component& get_or_create(entity_type entity) {
+    inline decltype(auto) get_or_create(entity_type entity) {
         auto& pool = components_.template ensure<Component>();
         return pool.get_or_create(entity);
     }
 
     template<typename Component>
-    inline const Component& get_or_default(entity_type entity) const {
+    inline decltype(auto) get_or_default(entity_type entity) const {
         const auto& pool = const_cast<component_database&>(components_).template ensure<Component>();
         return pool.get_or_default(entity);
     }
 
+    // see `entity_map::sort`
+    template<typename Component, typename Compare, typename Sort = std_sort>
+    inline void sort(Compare compare, Sort algorithm = Sort{}) {
+        components_.template ensure<Component>().sort(compare, algorithm);
+    }
+
+    // remove tombstones of `in_place_delete` pools, see `entity_map::pack`
+    template<typename ...Component>
+    inline void pack() {
+        (components_.template ensure<Component>().pack(), ...);
+    }
+
+    // order `Component` pool by `Other` pool, see `entity_map::respect`
+    template<typename Component, typename Other>
+    inline void respect() {
+        components_.template ensure<Component>().respect(components_.template ensure<Other>());
+    }
+
+    // single field of SoA component, see `component_traits::soa_layout`
+    template<auto Field>
+    inline auto& field(entity_type entity) {
+        auto* pool = components_.template try_get<field_class_t<Field>>();
+        assert(pool);
+        return pool->template field<Field>(entity);
+    }
+
+    /**
+     * field values of all SoA components in dense order of component pool,
+     * pools with the same entity order (for example, filled only by `create<A, B>(begin, end)`)
+     * could be processed by single vectorized loop over spans of their fields.
+     * Writes through span are not stamped as changed and don't emit `on_update`
+     **/
+    template<auto Field>
+    inline auto span() {
+        return components_.template ensure<field_class_t<Field>>().template span<Field>();
+    }
+
     template<typename Component>
     inline void remove(entity_type entity) {
         auto* pool = components_.template try_get<Component>();
@@ -109,9 +211,19 @@ public:
         return pool->erase(entity);
     }
 
-    template<typename ...Component>
-    inline auto view() {
-        return basic_view<EntityType, Component...>{components_};
+    // remove `Component` from range of entities, entities without it are skipped
+    template<typename Component, typename It>
+    inline void remove(It begin, It end) {
+        auto* pool = components_.template try_get<Component>();
+        if (pool) {
+            pool->erase(begin, end);
+        }
+    }
+
+    // entities with all `Component` and without any of `Excluded`
+    template<typename ...Component, typename ...Excluded>
+    inline auto view(exclude_t<Excluded...> = {}) {
+        return filtered_view<EntityType, exclude_t<Excluded...>, Component...>{components_};
     }
 
     /** special view provide back-to-front iteration
@@ -124,6 +236,12 @@ public:
 
     template<typename It>
     inline runtime_view_t<EntityType> runtime_view(It begin, It end) {
+        return runtime_view(begin, end, end, end);
+    }
+
+    // entities with all components of `begin..end` and without any of `exclude_begin..exclude_end`
+    template<typename It, typename ExcludeIt>
+    inline runtime_view_t<EntityType> runtime_view(It begin, It end, ExcludeIt exclude_begin, ExcludeIt exclude_end) {
         std::vector<entity_map_base<EntityType>*> table;
         for (auto it = begin; it != end; ++it) {
             auto* set = components_.try_get(*it);
@@ -131,7 +249,34 @@ public:
                 table.emplace_back(set);
             }
         }
-        return runtime_view_t(table);
+        std::vector<const entity_map_base<EntityType>*> excluded;
+        for (auto it = exclude_begin; it != exclude_end; ++it) {
+            // component is never used, so nothing is excluded by it
+            const auto* set = components_.try_get(*it);
+            if (set != nullptr) {
+                excluded.emplace_back(set);
+            }
+        }
+        return runtime_view_t(table, excluded);
+    }
+
+    /**
+     * change tracking clock, typical system loop:
+     * for (auto e : world.view<A>().changed_since<A>(last_tick)) {...}
+     * last_tick = world.tick();
+     * world.advance_tick();
+     **/
+    inline tick_type tick() const {
+        return components_.tick();
+    }
+
+    inline void advance_tick() {
+        components_.advance_tick();
+    }
+
+    // shared cache of empty sparse pages, use `high_water` / `trim` to limit memory held
+    inline auto& page_pool() {
+        return components_.page_pool();
     }
 
     inline const auto& pool() const {
@@ -143,10 +288,20 @@ public:
     }
 
     template<typename Component>
-    constexpr inline component_typeid type() noexcept {
+    inline component_typeid type() noexcept {
         return identity_generator<Component, component_typeid>::value;
     }
 
+    template<typename Component>
+    constexpr inline component_hash hash() noexcept {
+        return component_database::template hash<Component>();
+    }
+
+    // type-erased pool of component by `hash()`, nullptr if component is never used by world
+    inline auto* components(component_hash hash) const {
+        return components_.find(hash);
+    }
+
     inline auto create_wrapper() {
         return wrap(create());
     }
@@ -156,8 +311,12 @@ public:
     }
 
     inline bool valid(entity_type entity) const {
-        return entity != entity_type::null
-               && pool_.current(entity.index()) == entity.version();
+        return pool_.valid(entity);
+    }
+
+    template<typename It, typename Out>
+    inline Out valid(It begin, It end, Out out) const {
+        return pool_.valid(begin, end, out);
     }
 
 private:
@@ -166,5 +325,6 @@ private:
 };
 
 using world_t = base_world<uint32_t>;
+using world64_t = base_world<uint64_t>;
 
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include <ecxx/impl/archetype_world.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "common/components.h"
+
+using namespace ecxx;
+
+struct name_t {
+    std::string value;
+};
+
+TEST(archetype_world, assign_remove) {
+    archetype_world_t w;
+    auto e = w.create<position_t>();
+    ASSERT_TRUE(w.has<position_t>(e));
+    ASSERT_FALSE(w.has<value_t>(e));
+
+    w.get<position_t>(e).x = 1.0f;
+    w.assign<value_t>(e, 2);
+    w.assign<name_t>(e, "entity with long name, so string is allocated");
+    ASSERT_EQ(w.archetypes().size(), 4u);
+    ASSERT_EQ(w.get<position_t>(e).x, 1.0f);
+    ASSERT_EQ(w.get<value_t>(e).value, 2);
+    ASSERT_EQ(w.get<name_t>(e).value, "entity with long name, so string is allocated");
+
+    w.remove<position_t>(e);
+    ASSERT_FALSE(w.has<position_t>(e));
+    ASSERT_EQ(w.get<value_t>(e).value, 2);
+    ASSERT_EQ(w.get<name_t>(e).value, "entity with long name, so string is allocated");
+
+    // cached edges lead back to existing archetypes
+    w.assign<position_t>(e, 3.0f, 4.0f);
+    w.remove<value_t>(e);
+    w.remove<name_t>(e);
+    w.remove<position_t>(e);
+    ASSERT_FALSE(w.has<position_t>(e));
+    ASSERT_TRUE(w.valid(e));
+
+    w.replace_or_assign<value_t>(e, 5);
+    w.replace_or_assign<value_t>(e, 6);
+    ASSERT_EQ(w.get<value_t>(e).value, 6);
+
+    w.destroy(e);
+    ASSERT_FALSE(w.valid(e));
+}
+
+TEST(archetype_world, chunks) {
+    // small chunks to cover chunk boundaries
+    archetype_world_t w{std::pmr::get_default_resource(), 256u};
+    std::vector<archetype_world_t::entity_type> entities(1000);
+    w.create<position_t, value_t>(entities.begin(), entities.end());
+    for (uint32_t i = 0u; i < entities.size(); ++i) {
+        w.get<value_t>(entities[i]).value = static_cast<int>(i);
+        if (i % 2 == 0u) {
+            w.assign<name_t>(entities[i], std::to_string(i));
+        }
+    }
+    for (uint32_t i = 0u; i < entities.size(); i += 3u) {
+        w.destroy(entities[i]);
+    }
+
+    ASSERT_EQ(w.view<value_t>().size(), 666u);
+    ASSERT_EQ((w.view<value_t, name_t>().size()), 333u);
+
+    uint32_t count = 0u;
+    w.view<position_t, value_t>().each([&](auto e, auto&, auto& value) {
+        ASSERT_EQ(entities[value.value], e);
+        ASSERT_NE(value.value % 3, 0);
+        ++count;
+    });
+    ASSERT_EQ(count, 666u);
+
+    w.view<name_t, value_t>().each([](auto& name, auto& value) {
+        ASSERT_EQ(name.value, std::to_string(value.value));
+    });
+
+    std::vector<archetype_world_t::entity_type> alive;
+    for (auto e : entities) {
+        if (w.valid(e)) {
+            alive.push_back(e);
+        }
+    }
+    ASSERT_EQ(alive.size(), 666u);
+    w.destroy(alive.begin(), alive.end() - 1);
+    ASSERT_EQ(w.view<value_t>().size(), 1u);
+    ASSERT_EQ(w.get<value_t>(alive.back()).value, 998);
+}
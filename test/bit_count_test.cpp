@@ -21,3 +21,12 @@ TEST(bit_count, func) {
     ASSERT_EQ(bit_count(0xFFFFFFFFFFFFFFFF), 64);
 
 }
+
+TEST(bit_count, count_trailing_zeros) {
+    ASSERT_EQ(count_trailing_zeros(0x1), 0);
+    ASSERT_EQ(count_trailing_zeros(0x2), 1);
+    ASSERT_EQ(count_trailing_zeros(0x40000), 18);
+    ASSERT_EQ(count_trailing_zeros(0x80000000), 31);
+    ASSERT_EQ(count_trailing_zeros(0x8000000000000000), 63);
+    ASSERT_EQ(count_trailing_zeros(0xFFFFFFFFFFFFFFFF), 0);
+}
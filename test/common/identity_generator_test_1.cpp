@@ -25,3 +25,11 @@ TEST(identity_generator, test_1) {
     ASSERT_EQ((identity_generator<ig_a, uint16_t>::value), 1);
     ASSERT_EQ((identity_generator<ig_b, uint16_t>::value), 2);
 }
+
+TEST(identity_generator, type_hash) {
+    static_assert(type_hash<ig_a>() != type_hash<ig_b>());
+
+    ASSERT_EQ(type_name<ig_a>(), "ig_a");
+    ASSERT_EQ(type_name<int>(), "int");
+    ASSERT_NE(type_hash<ig_a>(), type_hash<ig_c>());
+}
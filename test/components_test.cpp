@@ -1,4 +1,6 @@
 #include <ecxx/ecxx.h>
+#include <memory>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include "common/components.h"
@@ -61,4 +63,124 @@ TEST(entity_wrapper, components_remove) {
 
     // todo: get should abort
     e.destroy();
-}
\ No newline at end of file
+}
+struct unique_t {
+    std::unique_ptr<int> value;
+};
+
+TEST(components, move_only) {
+    world_t world;
+    std::vector<world_t::entity_type> entities;
+    for (int i = 0; i < 10; ++i) {
+        auto e = world.create();
+        world.assign<unique_t>(e, std::make_unique<int>(i));
+        entities.push_back(e);
+    }
+    world.remove<unique_t>(entities[2]);
+    world.destroy(entities[5]);
+    world.replace_or_assign<unique_t>(entities[0], std::make_unique<int>(100));
+    world.replace_or_assign<unique_t>(entities[2], std::make_unique<int>(200));
+
+    ASSERT_EQ(*world.get<unique_t>(entities[0]).value, 100);
+    ASSERT_EQ(*world.get<unique_t>(entities[2]).value, 200);
+    ASSERT_EQ(*world.get<unique_t>(entities[9]).value, 9);
+    ASSERT_FALSE(world.has<unique_t>(entities[5]));
+
+    world.sort<unique_t>([](const auto& a, const auto& b) { return *a.value > *b.value; });
+    ASSERT_EQ(*world.get<unique_t>(entities[9]).value, 9);
+}
+
+TEST(components, replace_constructs_like_assign) {
+    world_t world;
+    auto e = world.create();
+    world.replace_or_assign<std::vector<int>>(e, 5u);
+    ASSERT_EQ(world.get<std::vector<int>>(e).size(), 5u);
+    world.replace_or_assign<std::vector<int>>(e, 3u);
+    ASSERT_EQ(world.get<std::vector<int>>(e).size(), 3u);
+    world.replace_or_assign<std::vector<int>>(e, std::vector<int>{1, 2});
+    ASSERT_EQ(world.get<std::vector<int>>(e), (std::vector<int>{1, 2}));
+}
+
+TEST(components, batch) {
+    world_t world;
+    std::vector<world_t::entity_type> entities(100);
+    world.create<position_t>(entities.begin(), entities.end());
+
+    world.assign<value_t>(entities.begin(), entities.begin() + 50, value_t{7});
+    world.assign<motion_t>(entities.begin() + 50, entities.end());
+    for (size_t i = 0u; i != entities.size(); ++i) {
+        ASSERT_EQ(world.has<value_t>(entities[i]), i < 50u);
+        ASSERT_EQ(world.has<motion_t>(entities[i]), i >= 50u);
+    }
+    ASSERT_EQ(world.get<value_t>(entities[49]).value, 7);
+
+    world.replace<value_t>(entities.begin() + 10, entities.begin() + 20, value_t{3});
+    ASSERT_EQ(world.get<value_t>(entities[9]).value, 7);
+    ASSERT_EQ(world.get<value_t>(entities[10]).value, 3);
+    ASSERT_EQ(world.get<value_t>(entities[19]).value, 3);
+
+    // entities without component are skipped
+    world.remove<value_t>(entities.begin() + 40, entities.begin() + 60);
+    for (size_t i = 0u; i != entities.size(); ++i) {
+        ASSERT_EQ(world.has<value_t>(entities[i]), i < 40u);
+        ASSERT_EQ(world.has<motion_t>(entities[i]), i >= 50u);
+    }
+    ASSERT_EQ(world.get<value_t>(entities[15]).value, 3);
+    ASSERT_EQ(world.get<value_t>(entities[39]).value, 7);
+}
+
+TEST(components, signals) {
+    struct counters {
+        int constructed = 0;
+        int destroyed = 0;
+        int updated = 0;
+        int last_value = -1;
+    } c;
+    using entity_type = world_t::entity_type;
+
+    world_t world;
+    world.on_construct<value_t>().connect([](void* context, entity_type) {
+        ++static_cast<counters*>(context)->constructed;
+    }, &c);
+    world.on_update<value_t>().connect([](void* context, entity_type) {
+        ++static_cast<counters*>(context)->updated;
+    }, &c);
+    world.on_destroy<value_t>().connect([](void* context, entity_type) {
+        ++static_cast<counters*>(context)->destroyed;
+    }, &c);
+
+    std::vector<entity_type> entities(10);
+    world.create<value_t>(entities.begin(), entities.end());
+    auto e = world.create();
+    world.assign<value_t>(e, 5);
+    ASSERT_EQ(c.constructed, 11);
+
+    world.replace_or_assign<value_t>(e, 6);
+    world.replace<value_t>(entities.begin(), entities.begin() + 3, value_t{1});
+    ASSERT_EQ(c.updated, 4);
+
+    world.remove<value_t>(e);
+    world.destroy(entities.begin(), entities.begin() + 5);
+    world.destroy(entities[9]);
+    ASSERT_EQ(c.destroyed, 7);
+
+    auto mark = +[](void* context, entity_type) {
+        static_cast<counters*>(context)->last_value = 0;
+    };
+    world.on_destroy<value_t>().connect(mark, &c);
+    world.on_destroy<value_t>().disconnect(mark, &c);
+    world.remove<value_t>(entities.begin() + 5, entities.end());
+    ASSERT_EQ(c.destroyed, 11);
+    ASSERT_EQ(c.last_value, -1);
+}
+
+TEST(components, find_by_hash) {
+    world_t w;
+    auto e = w.create<position_t>();
+    constexpr auto hash = world_t::component_database::hash<position_t>();
+
+    auto* pool = w.components(hash);
+    ASSERT_NE(pool, nullptr);
+    ASSERT_TRUE(pool->has(e));
+    ASSERT_EQ(w.components(w.hash<value_t>()), nullptr);
+}
@@ -1,4 +1,5 @@
 #include <ecxx/impl/entity_map.h>
+#include <ecxx/impl/memory_resource.h>
 #include <gtest/gtest.h>
 
 using namespace ecxx;
@@ -13,3 +14,234 @@ TEST(v2_entity_map, simple) {
     m.emplace({5u, 0u}, 1);
     ASSERT_TRUE(m.has({5u, 0u}));
 }
+
+TEST(v2_entity_map, erase_batch) {
+    using entity_type = entity_value<uint32_t>;
+    entity_map<uint32_t, int> m;
+    for (uint32_t i = 1u; i <= 10u; ++i) {
+        m.emplace({i, 0u}, static_cast<int>(i));
+    }
+
+    entity_type erased[] = {{2u, 0u}, {10u, 0u}, {5u, 0u}, {20u, 0u}, {5u, 0u}, {9u, 0u}};
+    m.erase(std::begin(erased), std::end(erased));
+
+    ASSERT_EQ(m.size(), 6u);
+    for (uint32_t i = 1u; i <= 10u; ++i) {
+        const bool alive = i != 2u && i != 5u && i != 9u && i != 10u;
+        ASSERT_EQ(m.has({i, 0u}), alive);
+        if (alive) {
+            ASSERT_EQ(m.get({i, 0u}), i);
+        }
+    }
+    for (auto e : m) {
+        ASSERT_TRUE(m.has(e));
+    }
+}
+
+struct rare_component {
+    int value = 0;
+};
+
+template<>
+struct ecxx::component_traits<rare_component> : ecxx::default_component_traits {
+    static constexpr uint32_t page_size = 0x100u;
+    static constexpr uint32_t initial_capacity = 100u;
+    static constexpr uint32_t growth_percent = 50u;
+};
+
+TEST(v2_entity_map, component_traits) {
+    entity_map<uint32_t, rare_component> m;
+    ASSERT_GE(m.capacity(), 100u);
+
+    for (uint32_t i = 1u; i <= 1000u; ++i) {
+        m.emplace({i * 7u, 0u}, static_cast<int>(i));
+    }
+    ASSERT_EQ(m.size(), 1000u);
+    ASSERT_GE(m.capacity(), 1000u);
+    for (uint32_t i = 1u; i <= 1000u; ++i) {
+        ASSERT_EQ(m.get({i * 7u, 0u}).value, i);
+        ASSERT_FALSE(m.has({i * 7u + 1u, 0u}));
+    }
+}
+
+TEST(v2_entity_map, small_page_empty_pool) {
+    // page table of small pages grows on insert instead of covering whole index range
+    memory_counter counter;
+    entity_map<uint32_t, rare_component> m{nullptr, &counter};
+    ASSERT_LT(counter.bytes(), 0x1000u);
+
+    m.emplace({1000u, 0u}, 1);
+    ASSERT_LT(counter.bytes(), 0x1000u);
+    ASSERT_EQ(m.get({1000u, 0u}).value, 1);
+    ASSERT_FALSE(m.has({(1u << 20u) - 1u, 0u}));
+}
+
+struct chunked_component {
+    int value = 0;
+};
+
+template<>
+struct ecxx::component_traits<chunked_component> : ecxx::default_component_traits {
+    static constexpr uint32_t chunk_size = 4u;
+};
+
+TEST(v2_entity_map, chunked_storage) {
+    using entity_type = entity_value<uint32_t>;
+    entity_map<uint32_t, chunked_component> m;
+
+    auto* first = &m.emplace({1u, 0u}, 1);
+    for (uint32_t i = 2u; i <= 100u; ++i) {
+        m.emplace({i, 0u}, static_cast<int>(i));
+    }
+    // growth doesn't move components
+    ASSERT_EQ(first, &m.get({1u, 0u}));
+    ASSERT_GE(m.capacity(), 100u);
+
+    entity_type erased[] = {{2u, 0u}, {50u, 0u}, {100u, 0u}};
+    m.erase(std::begin(erased), std::end(erased));
+    m.erase({3u, 0u});
+    ASSERT_EQ(m.size(), 96u);
+    for (uint32_t i = 1u; i <= 100u; ++i) {
+        const bool alive = i != 2u && i != 3u && i != 50u && i != 100u;
+        ASSERT_EQ(m.has({i, 0u}), alive);
+        if (alive) {
+            ASSERT_EQ(m.get({i, 0u}).value, i);
+        }
+    }
+}
+
+struct soa_component {
+    float x = 0.0f;
+    int y = 0;
+};
+
+template<>
+struct ecxx::component_traits<soa_component> : ecxx::default_component_traits {
+    using soa_layout = ecxx::soa_fields<&soa_component::x, &soa_component::y>;
+};
+
+TEST(v2_entity_map, soa_storage) {
+    using entity_type = entity_value<uint32_t>;
+    entity_map<uint32_t, soa_component> m;
+    for (uint32_t i = 1u; i <= 100u; ++i) {
+        m.emplace({i, 0u}, static_cast<float>(i), static_cast<int>(i));
+    }
+
+    auto xs = m.span<&soa_component::x>();
+    ASSERT_EQ(xs.size(), 100u);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(xs.data()) % 64u, 0u);
+    for (auto& x : xs) {
+        x *= 2.0f;
+    }
+    m.field<&soa_component::y>({7u, 0u}) = -7;
+
+    entity_type erased[] = {{2u, 0u}, {50u, 0u}};
+    m.erase(std::begin(erased), std::end(erased));
+    m.erase({3u, 0u});
+    ASSERT_EQ(m.size(), 97u);
+    for (uint32_t i = 1u; i <= 100u; ++i) {
+        const bool alive = i != 2u && i != 3u && i != 50u;
+        ASSERT_EQ(m.has({i, 0u}), alive);
+        if (alive) {
+            const soa_component c = m.get({i, 0u});
+            ASSERT_EQ(c.x, 2.0f * i);
+            ASSERT_EQ(c.y, i == 7u ? -7 : static_cast<int>(i));
+        }
+    }
+    ASSERT_EQ(m.get_or_default({3u, 0u}).y, 0);
+}
+
+TEST(v2_entity_map, sort) {
+    entity_map<uint32_t, int> m;
+    const int values[] = {5, 3, 9, 1, 7, 2, 8};
+    for (uint32_t i = 0u; i != std::size(values); ++i) {
+        m.emplace({i + 1u, 0u}, values[i]);
+    }
+
+    m.sort([](int a, int b) { return a < b; });
+    int prev = 0;
+    for (auto e : m) {
+        ASSERT_LT(prev, m.get(e));
+        ASSERT_EQ(m.get(e), values[e.index() - 1u]);
+        prev = m.get(e);
+    }
+
+    // nearly sorted: single element out of order
+    m.get({4u, 0u}) = 10;
+    m.sort([](int a, int b) { return a > b; }, insertion_sort{});
+    prev = 11;
+    for (auto e : m) {
+        ASSERT_GT(prev, m.get(e));
+        prev = m.get(e);
+    }
+    ASSERT_EQ(*m.begin(), entity_value<uint32_t>(4u, 0u));
+
+    // compare entities
+    using entity_type = entity_value<uint32_t>;
+    m.sort([](entity_type a, entity_type b) { return a.index() < b.index(); }, insertion_sort{});
+    uint32_t index = 1u;
+    for (auto e : m) {
+        ASSERT_EQ(e.index(), index++);
+        ASSERT_TRUE(m.has(e));
+    }
+}
+
+TEST(v2_entity_map, respect) {
+    using entity_type = entity_value<uint32_t>;
+    entity_map<uint32_t, int> a;
+    entity_map<uint32_t, int> b;
+    const uint32_t a_order[] = {5u, 1u, 4u, 9u, 2u};
+    const uint32_t b_order[] = {2u, 7u, 9u, 1u, 8u, 5u};
+    for (auto i : a_order) {
+        a.emplace({i, 0u}, static_cast<int>(i));
+    }
+    for (auto i : b_order) {
+        b.emplace({i, 0u}, static_cast<int>(i));
+    }
+
+    b.respect(a);
+
+    const uint32_t expected[] = {5u, 1u, 9u, 2u};
+    for (uint32_t i = 0u; i != std::size(expected); ++i) {
+        ASSERT_EQ(b.at(i + 1u).index(), expected[i]);
+    }
+    ASSERT_EQ(b.size(), 6u);
+    for (auto i : b_order) {
+        ASSERT_EQ(b.get(entity_type{i, 0u}), i);
+    }
+}
+
+struct stable_component {
+    int value = 0;
+};
+
+template<>
+struct ecxx::component_traits<stable_component> : ecxx::default_component_traits {
+    static constexpr bool in_place_delete = true;
+};
+
+TEST(v2_entity_map, in_place_delete) {
+    using entity_type = entity_value<uint32_t>;
+    entity_map<uint32_t, stable_component> m;
+    for (uint32_t i = 1u; i <= 10u; ++i) {
+        m.emplace({i, 0u}, static_cast<int>(i));
+    }
+
+    m.erase({3u, 0u});
+    entity_type erased[] = {{1u, 0u}, {7u, 0u}, {20u, 0u}};
+    m.erase(std::begin(erased), std::end(erased));
+    ASSERT_EQ(m.tombstones(), 3u);
+    ASSERT_EQ(m.size(), 10u);
+    ASSERT_FALSE(m.has({3u, 0u}));
+    ASSERT_EQ(m.get({10u, 0u}).value, 10);
+
+    m.pack();
+    ASSERT_EQ(m.tombstones(), 0u);
+    ASSERT_EQ(m.size(), 7u);
+    const uint32_t expected[] = {2u, 4u, 5u, 6u, 8u, 9u, 10u};
+    for (uint32_t i = 0u; i != std::size(expected); ++i) {
+        const auto e = m.at(i + 1u);
+        ASSERT_EQ(e.index(), expected[i]);
+        ASSERT_EQ(m.get(e).value, expected[i]);
+    }
+}
@@ -1,5 +1,7 @@
 #include <ecxx/impl/entity_pool.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
 
 using namespace ecxx;
 
@@ -94,4 +96,169 @@ TEST(v2_entity_allocator, recycle) {
     for (int i = 5; i < active.size(); ++i) {
         ASSERT_EQ(active[i].index(), i + 1);
     }
-}
\ No newline at end of file
+}
+TEST(v2_entity_allocator, allocate_batch) {
+    entity_allocator allocator;
+
+    std::vector<entity_allocator::value_type> active(5);
+    allocator.allocate(active.begin(), active.end());
+    for (int i = 0; i < active.size(); ++i) {
+        ASSERT_EQ(active[i].index(), i + 1);
+    }
+
+    allocator.deallocate(active[1]);
+    allocator.deallocate(active[3]);
+
+    std::vector<entity_allocator::value_type> batch(4);
+    allocator.allocate(batch.begin(), batch.end());
+
+    ASSERT_EQ(allocator.available_for_recycling(), 0);
+    ASSERT_EQ(allocator.size(), 7);
+    ASSERT_EQ(count_entities(allocator), 7);
+
+    ASSERT_EQ(batch[0].index(), 4);
+    ASSERT_EQ(batch[1].index(), 2);
+    ASSERT_EQ(batch[2].index(), 6);
+    ASSERT_EQ(batch[3].index(), 7);
+
+    ASSERT_NE(batch[0].version(), active[3].version());
+    for (auto e : batch) {
+        ASSERT_TRUE(allocator.is_alive(e.index()));
+        ASSERT_EQ(allocator.current(e.index()), e.version());
+    }
+}
+
+TEST(v2_entity_allocator, allocate_concurrent) {
+    entity_allocator allocator;
+
+    std::vector<entity_allocator::value_type> active(100);
+    allocator.allocate(active.begin(), active.end());
+    for (uint32_t i = 0; i < active.size(); i += 2) {
+        allocator.deallocate(active[i]);
+    }
+
+    constexpr uint32_t threads_num = 4u;
+    constexpr uint32_t per_thread = 1000u;
+    std::vector<entity_allocator::value_type> minted(threads_num * per_thread);
+
+    allocator.begin_concurrent();
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < threads_num; ++t) {
+        threads.emplace_back([&allocator, &minted, t] {
+            auto* out = minted.data() + t * per_thread;
+            // mix single and block allocations
+            for (uint32_t i = 0; i < per_thread / 2; ++i) {
+                out[i] = allocator.allocate_concurrent();
+            }
+            allocator.allocate_concurrent(out + per_thread / 2, out + per_thread);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    allocator.end_concurrent();
+
+    ASSERT_EQ(allocator.available_for_recycling(), 0);
+    ASSERT_EQ(allocator.size(), 50 + minted.size());
+    ASSERT_EQ(count_entities(allocator), allocator.size());
+
+    std::vector<uint32_t> indices;
+    for (auto e : minted) {
+        ASSERT_TRUE(allocator.is_alive(e.index()));
+        ASSERT_EQ(allocator.current(e.index()), e.version());
+        indices.push_back(e.index());
+    }
+    std::sort(indices.begin(), indices.end());
+    ASSERT_TRUE(std::adjacent_find(indices.begin(), indices.end()) == indices.end());
+    ASSERT_EQ(indices.back(), 50 + minted.size());
+
+    // pool keeps working in regular mode
+    allocator.deallocate(minted[0]);
+    allocator.begin_concurrent();
+    auto e = allocator.allocate_concurrent();
+    auto fresh = allocator.allocate_concurrent();
+    allocator.end_concurrent();
+    ASSERT_EQ(e.index(), minted[0].index());
+    ASSERT_NE(e.version(), minted[0].version());
+    ASSERT_EQ(fresh.index(), 51 + minted.size());
+    ASSERT_EQ(allocator.size(), 51 + minted.size());
+}
+
+TEST(v2_entity_allocator, concurrent_partial_recycle) {
+    entity_allocator allocator;
+
+    std::vector<entity_allocator::value_type> active(10);
+    allocator.allocate(active.begin(), active.end());
+    for (auto e : active) {
+        allocator.deallocate(e);
+    }
+
+    allocator.begin_concurrent();
+    auto a = allocator.allocate_concurrent();
+    auto b = allocator.allocate_concurrent();
+    allocator.end_concurrent();
+
+    // same order as regular allocation
+    ASSERT_EQ(a.index(), 10);
+    ASSERT_EQ(b.index(), 9);
+    ASSERT_EQ(allocator.available_for_recycling(), 8);
+    ASSERT_EQ(allocator.allocate().index(), 8);
+    ASSERT_EQ(allocator.size(), 3);
+}
+
+TEST(v2_entity_allocator, each_sparse) {
+    entity_allocator allocator;
+
+    std::vector<entity_allocator::value_type> active(1000);
+    allocator.allocate(active.begin(), active.end());
+    for (uint32_t i = 0; i < active.size(); ++i) {
+        if (i % 97 != 0u) {
+            allocator.deallocate(active[i]);
+        }
+    }
+
+    std::vector<entity_allocator::value_type> visited;
+    allocator.each([&visited](auto e) {
+        visited.push_back(e);
+    });
+    ASSERT_EQ(visited.size(), allocator.size());
+    for (uint32_t i = 0; i < visited.size(); ++i) {
+        ASSERT_EQ(visited[i], active[i * 97]);
+    }
+
+    // deallocate during iteration
+    uint32_t count = 0u;
+    allocator.each([&allocator, &active, &count](auto e) {
+        ++count;
+        if (e == active[0]) {
+            allocator.deallocate(active[97]);
+        }
+    });
+    ASSERT_EQ(count, visited.size() - 1u);
+    ASSERT_EQ(count_entities(allocator), allocator.size());
+}
+
+TEST(v2_entity_allocator, valid_batch) {
+    entity_allocator allocator;
+
+    std::vector<entity_allocator::value_type> active(100);
+    allocator.allocate(active.begin(), active.end());
+    allocator.deallocate(active[3]);
+    allocator.deallocate(active[70]);
+    auto recycled = allocator.allocate();
+
+    entity_allocator::value_type query[] = {
+            active[0], active[3], active[70], recycled, entity_allocator::value_type::null, {1000u, 0u}
+    };
+    bool result[std::size(query)];
+    allocator.valid(std::begin(query), std::end(query), result);
+
+    ASSERT_TRUE(result[0]);
+    ASSERT_FALSE(result[1]);
+    ASSERT_FALSE(result[2]);
+    ASSERT_TRUE(result[3]);
+    ASSERT_FALSE(result[4]);
+    ASSERT_FALSE(result[5]);
+    ASSERT_EQ(allocator.valid(recycled), true);
+    ASSERT_EQ(allocator.valid(active[70]), false);
+}
@@ -17,4 +17,43 @@ TEST(entity_value, basic) {
     e.version(99);
     ASSERT_EQ(e.index(), 23u);
     ASSERT_EQ(e.version(), 99u);
-}
\ No newline at end of file
+}
+TEST(entity_value, wide) {
+    using entity_t = entity_value<uint64_t>;
+    using spec = entity_spec<uint64_t>;
+    static_assert(spec::index_bits == 32u && spec::version_bits == 32u);
+    static_assert(sizeof(spec::index_type) == 4u && sizeof(spec::version_type) == 4u);
+
+    entity_t e{0xFFFFFFFFu, 0x80000001u};
+    ASSERT_EQ(e.index(), 0xFFFFFFFFu);
+    ASSERT_EQ(e.version(), 0x80000001u);
+
+    e.index(0x100000u);
+    e.version(0xFFFFFFFFu);
+    ASSERT_EQ(e.index(), 0x100000u);
+    ASSERT_EQ(e.version(), 0xFFFFFFFFu);
+}
+
+struct custom_entity_tag;
+
+namespace ecxx {
+template<>
+struct entity_spec<custom_entity_tag> : basic_entity_spec<uint32_t, 24u> {
+};
+}
+
+TEST(entity_value, custom_spec) {
+    using entity_t = entity_value<custom_entity_tag>;
+    using spec = entity_spec<custom_entity_tag>;
+    static_assert(spec::version_bits == 8u && spec::version_mask == 0xFFu);
+    static_assert(std::is_same_v<spec::version_type, uint8_t>);
+
+    entity_t e{0xFFFFFFu, 0xFFu};
+    ASSERT_EQ(e.index(), 0xFFFFFFu);
+    ASSERT_EQ(e.version(), 0xFFu);
+
+    // version wraps without touching index bits
+    e.version(static_cast<spec::version_type>(e.version() + 1u));
+    ASSERT_EQ(e.index(), 0xFFFFFFu);
+    ASSERT_EQ(e.version(), 0u);
+}
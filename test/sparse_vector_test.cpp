@@ -1,10 +1,11 @@
 #include <ecxx/impl/sparse_vector.h>
+#include <ecxx/impl/sparse_vector_mmap.h>
 #include <gtest/gtest.h>
 
 using namespace ecxx;
 
 TEST(sparse_vector, basic) {
-    sparse_vector<int> v;
+    sparse_vector<int, 0, 0x8000u, uint32_t, (1u << 16u)> v;
     ASSERT_FALSE(v.has(2));
     ASSERT_FALSE(v.has(3, 3));
 
@@ -25,3 +26,102 @@ TEST(sparse_vector, basic) {
     ASSERT_EQ(v.at(4), 0);
     ASSERT_FALSE(v.has(4));
 }
+
+TEST(sparse_vector_mmap, basic) {
+    sparse_vector_mmap<uint32_t, 1u << 20u> v;
+    ASSERT_FALSE(v.has(2));
+    ASSERT_FALSE(v.has((1u << 20u) - 1u));
+
+    v.insert(2, 1);
+    v.insert(0xFFFFF, 3);
+
+    ASSERT_TRUE(v.has(2));
+    ASSERT_TRUE(v.has(0xFFFFF));
+    ASSERT_EQ(v.at(2), 1);
+    ASSERT_EQ(v.at(0xFFFFF), 3);
+
+    v.replace(2, 5);
+    ASSERT_EQ(v.get_and_remove(2), 5);
+    ASSERT_FALSE(v.has(2));
+
+    v.clear();
+    ASSERT_FALSE(v.has(0xFFFFF));
+    v.insert(0xFFFFF, 1);
+    ASSERT_EQ(v.at(0xFFFFF), 1);
+}
+
+TEST(sparse_vector, page_reclaim) {
+    // 16 elements per page
+    using vector_type = sparse_vector<int, 0, 64u, uint32_t, (1u << 10u)>;
+    vector_type::page_pool_type page_pool;
+
+    {
+        vector_type v{&page_pool};
+        v.insert(1, 1);
+        v.insert(2, 1);
+        v.insert(17, 1);
+        ASSERT_EQ(v.pages_allocated(), 2u);
+
+        v.remove(1);
+        ASSERT_EQ(v.pages_allocated(), 2u);
+        v.remove(2);
+        ASSERT_EQ(v.pages_allocated(), 1u);
+        ASSERT_EQ(page_pool.free_pages(), 1u);
+        ASSERT_FALSE(v.has(1));
+        ASSERT_EQ(v.at(2), 0);
+
+        // page is reused from pool and stays clean
+        v.insert(40, 2);
+        ASSERT_EQ(page_pool.free_pages(), 0u);
+        for (uint32_t i = 32; i < 48; ++i) {
+            ASSERT_EQ(v.has(i), i == 40);
+        }
+    }
+    ASSERT_EQ(page_pool.free_pages(), 2u);
+
+    vector_type other{&page_pool};
+    other.insert(3, 1);
+    ASSERT_EQ(page_pool.free_pages(), 1u);
+    ASSERT_EQ(other.at(3), 1);
+    ASSERT_FALSE(other.has(4));
+
+    page_pool.high_water(0u);
+    ASSERT_EQ(page_pool.free_pages(), 0u);
+    other.remove(3);
+    ASSERT_EQ(page_pool.free_pages(), 0u);
+}
+
+TEST(sparse_vector, page_size) {
+    sparse_vector<uint32_t, 0u, 0x8000u, uint32_t, (1u << 20u)> v{nullptr, 0x100u};
+    ASSERT_EQ(v.elements_per_page(), 64u);
+
+    v.insert(63, 1);
+    v.insert(64, 2);
+    v.insert(100000, 3);
+    ASSERT_EQ(v.pages_allocated(), 3u);
+    ASSERT_EQ(v.at(63), 1u);
+    ASSERT_EQ(v.at(64), 2u);
+    ASSERT_EQ(v.at(100000), 3u);
+    ASSERT_FALSE(v.has(65));
+}
+
+TEST(sparse_vector, wide_capacity) {
+    // page table for 32-bit index range is not allocated up front
+    sparse_vector<uint32_t, 0u, 0x100u, uint32_t, (uint64_t{1u} << 32u)> v;
+    ASSERT_EQ(v.table_size(), 0u);
+    ASSERT_FALSE(v.has(0xFFFFFFFFu));
+    ASSERT_EQ(v.at(1000u), 0u);
+
+    v.insert(100u, 1u);
+    ASSERT_EQ(v.table_size(), 2u);
+    v.insert(1000u, 2u);
+    ASSERT_EQ(v.table_size(), 16u);
+    ASSERT_EQ(v.pages_allocated(), 2u);
+    ASSERT_EQ(v.at(100u), 1u);
+    ASSERT_EQ(v.at(1000u), 2u);
+    ASSERT_FALSE(v.has(0xFFFFFFFFu));
+
+    v.remove(1000u);
+    ASSERT_FALSE(v.has(1000u));
+    ASSERT_EQ(v.pages_allocated(), 1u);
+}
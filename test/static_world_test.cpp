@@ -0,0 +1,108 @@
+#include <ecxx/impl/static_world.h>
+#include <gtest/gtest.h>
+#include "common/components.h"
+
+using namespace ecxx;
+
+using static_world_t = static_world<position_t, motion_t, value_t>;
+
+struct static_soa_t {
+    float x = 0.0f;
+    int y = 0;
+};
+
+template<>
+struct ecxx::component_traits<static_soa_t> : ecxx::default_component_traits {
+    using soa_layout = ecxx::soa_fields<&static_soa_t::x, &static_soa_t::y>;
+};
+
+TEST(static_world, basic) {
+    static_world_t w;
+    auto e = w.create<position_t, value_t>();
+    ASSERT_TRUE(w.valid(e));
+    ASSERT_TRUE(w.has<position_t>(e));
+    ASSERT_TRUE(w.has<value_t>(e));
+    ASSERT_FALSE(w.has<motion_t>(e));
+
+    w.get<position_t>(e).x = 1.0f;
+    w.replace_or_assign<value_t>(e, 2);
+    w.assign<motion_t>(e, 3.0f, 4.0f);
+    ASSERT_EQ(w.get<position_t>(e).x, 1.0f);
+    ASSERT_EQ(w.get<value_t>(e).value, 2);
+    ASSERT_EQ(w.get<motion_t>(e).vy, 4.0f);
+
+    w.remove<motion_t>(e);
+    ASSERT_FALSE(w.has<motion_t>(e));
+
+    w.destroy(e);
+    ASSERT_FALSE(w.valid(e));
+    ASSERT_EQ(w.storage<position_t>().size(), 0u);
+    ASSERT_EQ(w.storage<value_t>().size(), 0u);
+}
+
+TEST(static_world, view) {
+    static_world_t w;
+    std::vector<static_world_t::entity_type> entities(100);
+    w.create<position_t>(entities.begin(), entities.end());
+    for (uint32_t i = 0; i < entities.size(); i += 2) {
+        w.assign<value_t>(entities[i], static_cast<int>(i));
+    }
+
+    int sum = 0;
+    uint32_t count = 0u;
+    w.view<position_t, value_t>().each([&](auto&, auto& value) {
+        sum += value.value;
+        ++count;
+    });
+    ASSERT_EQ(count, 50u);
+    ASSERT_EQ(sum, 2450);
+
+    count = 0u;
+    for (auto e : w.rview<value_t>()) {
+        ASSERT_TRUE(w.has<value_t>(e));
+        ++count;
+    }
+    ASSERT_EQ(count, 50u);
+
+    const uint32_t types[] = {w.type<value_t>(), w.type<position_t>()};
+    count = 0u;
+    w.runtime_view(std::begin(types), std::end(types)).each([&count](auto) {
+        ++count;
+    });
+    ASSERT_EQ(count, 50u);
+
+    w.destroy(entities.begin(), entities.end());
+    ASSERT_EQ(w.storage<position_t>().size(), 0u);
+    ASSERT_EQ(w.storage<value_t>().size(), 0u);
+}
+
+TEST(static_world, hash) {
+    static_world_t w;
+    auto e = w.create<value_t>();
+    ASSERT_EQ(w.components(w.hash<value_t>()), &w.storage<value_t>());
+    ASSERT_TRUE(w.components(w.hash<value_t>())->has(e));
+    ASSERT_EQ(w.components(w.hash<int>()), nullptr);
+}
+
+TEST(static_world, exclude) {
+    static_world_t w;
+    auto a = w.create<position_t>();
+    w.create<position_t, value_t>();
+    uint32_t count = 0u;
+    for (auto e : w.view<position_t>(exclude<value_t>)) {
+        ASSERT_EQ(e, a);
+        ++count;
+    }
+    ASSERT_EQ(count, 1u);
+}
+
+TEST(static_world, get_or_create_soa) {
+    static_world<position_t, static_soa_t> w;
+    auto e = w.create<position_t>();
+    const static_soa_t created = w.get_or_create<static_soa_t>(e);
+    ASSERT_TRUE(w.has<static_soa_t>(e));
+    ASSERT_EQ(created.x, 0.0f);
+    w.field<&static_soa_t::x>(e) = 3.0f;
+    ASSERT_EQ(w.get_or_create<static_soa_t>(e).x, 3.0f);
+    ASSERT_EQ(&w.get_or_create<position_t>(e), &w.get<position_t>(e));
+}
@@ -1,9 +1,19 @@
 #include <ecxx/ecxx.h>
 #include <gtest/gtest.h>
+#include <vector>
 #include "common/components.h"
 
 using namespace ecxx;
 
+struct stable_t {
+    int value = 0;
+};
+
+template<>
+struct ecxx::component_traits<stable_t> : ecxx::default_component_traits {
+    static constexpr bool in_place_delete = true;
+};
+
 TEST(view, each) {
     world_t w;
     w.create<position_t, motion_t>();
@@ -64,3 +74,142 @@ TEST(runtime_view, min_to_max) {
 
     ASSERT_EQ(view_count, values_count);
 }
+
+TEST(view, erase_in_place_during_iteration) {
+    world_t w;
+    std::vector<world_t::entity_type> entities(10);
+    w.create<stable_t, value_t>(entities.begin(), entities.end());
+    for (size_t i = 0u; i != entities.size(); ++i) {
+        w.get<stable_t>(entities[i]).value = static_cast<int>(i);
+    }
+
+    std::vector<int> visited;
+    for (auto e : w.view<stable_t>()) {
+        const int value = w.get<stable_t>(e).value;
+        visited.push_back(value);
+        if (value % 3 == 0) {
+            w.remove<stable_t>(e);
+        }
+    }
+    ASSERT_EQ(visited, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+    visited.clear();
+    w.view<stable_t, value_t>().each([&visited](const stable_t& s, const value_t&) {
+        visited.push_back(s.value);
+    });
+    ASSERT_EQ(visited, (std::vector<int>{1, 2, 4, 5, 7, 8}));
+
+    w.pack<stable_t>();
+    visited.clear();
+    for (auto e : w.view<stable_t>()) {
+        visited.push_back(w.get<stable_t>(e).value);
+    }
+    ASSERT_EQ(visited, (std::vector<int>{1, 2, 4, 5, 7, 8}));
+}
+
+struct tracked_t {
+    int value = 0;
+};
+
+template<>
+struct ecxx::component_traits<tracked_t> : ecxx::default_component_traits {
+    static constexpr bool track_changes = true;
+};
+
+TEST(view, changed_since) {
+    world_t w;
+    std::vector<world_t::entity_type> entities(10);
+    w.create<tracked_t, value_t>(entities.begin(), entities.end());
+
+    auto count_changed = [&w](world_t::tick_type tick) {
+        int count = 0;
+        for (auto e : w.view<tracked_t, value_t>().changed_since<tracked_t>(tick)) {
+            count += w.has<tracked_t>(e) ? 1 : 0;
+        }
+        return count;
+    };
+
+    ASSERT_EQ(count_changed(0u), 10);
+    auto last_tick = w.tick();
+    w.advance_tick();
+    ASSERT_EQ(count_changed(last_tick), 0);
+
+    w.get<tracked_t>(entities[3]).value = 3;
+    w.replace_or_assign<tracked_t>(entities[5], 5);
+    // const access doesn't stamp
+    const auto& cw = w;
+    ASSERT_EQ(cw.get<tracked_t>(entities[7]).value, 0);
+    w.remove<tracked_t>(entities[0]);
+    ASSERT_EQ(count_changed(last_tick), 2);
+
+    w.sort<tracked_t>([](const tracked_t& a, const tracked_t& b) { return a.value > b.value; });
+    ASSERT_EQ(count_changed(last_tick), 2);
+
+    last_tick = w.tick();
+    w.advance_tick();
+    int visited = 0;
+    w.view<tracked_t>().changed_since<tracked_t>(last_tick).each([&visited](tracked_t&) { ++visited; });
+    ASSERT_EQ(visited, 0);
+    // mutable view access stamps components
+    w.view<tracked_t>().each([](tracked_t& t) { ++t.value; });
+    ASSERT_EQ(count_changed(last_tick), 9);
+}
+
+TEST(view, const_each_is_not_changed) {
+    world_t w;
+    std::vector<world_t::entity_type> entities(10);
+    w.create<tracked_t, value_t>(entities.begin(), entities.end());
+    const auto last_tick = w.tick();
+    w.advance_tick();
+
+    int sum = 0;
+    w.view<tracked_t>().each([&sum](const tracked_t& t) { sum += t.value; });
+    w.view<value_t, tracked_t>().each([&sum](value_t&, tracked_t t) { sum += t.value; });
+    w.rview<tracked_t>().each([&sum](const tracked_t& t) { sum += t.value; });
+    ASSERT_EQ(sum, 0);
+    ASSERT_EQ(w.view<tracked_t>().changed_since<tracked_t>(last_tick).begin(),
+              w.view<tracked_t>().changed_since<tracked_t>(last_tick).end());
+
+    // only components taken by non-const reference are stamped
+    w.view<value_t, tracked_t>().each([](const value_t&, tracked_t& t) { ++t.value; });
+    uint32_t changed = 0u;
+    for (auto e : w.view<tracked_t>().changed_since<tracked_t>(last_tick)) {
+        ASSERT_TRUE(w.valid(e));
+        ++changed;
+    }
+    ASSERT_EQ(changed, 10u);
+}
+
+TEST(view, exclude) {
+    world_t w;
+    // excluded pool is the smallest, it must not become the pivot
+    for (uint32_t i = 0; i < 100; ++i) {
+        auto e = w.create<position_t, motion_t>();
+        if (i % 10 == 0u) {
+            w.assign<value_t>(e, static_cast<int>(i));
+        }
+    }
+
+    uint32_t count = 0u;
+    w.view<position_t, motion_t>(exclude<value_t>).each([&count](auto&, auto&) {
+        ++count;
+    });
+    ASSERT_EQ(count, 90u);
+
+    count = 0u;
+    for (auto e : w.view<position_t>(exclude<value_t, stable_t>)) {
+        ASSERT_FALSE(w.has<value_t>(e));
+        ++count;
+    }
+    ASSERT_EQ(count, 90u);
+
+    world_t::component_typeid types[] = {w.type<position_t>(), w.type<motion_t>()};
+    world_t::component_typeid excluded[] = {w.type<value_t>()};
+    count = 0u;
+    w.runtime_view(std::begin(types), std::end(types), std::begin(excluded), std::end(excluded)).each(
+            [&w, &count](auto e) {
+                ASSERT_FALSE(w.has<value_t>(e));
+                ++count;
+            });
+    ASSERT_EQ(count, 90u);
+}
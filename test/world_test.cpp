@@ -1,5 +1,7 @@
 #include <ecxx/impl/world.h>
+#include <ecxx/impl/memory_resource.h>
 #include <gtest/gtest.h>
+#include "common/components.h"
 
 using namespace ecxx;
 
@@ -9,3 +11,226 @@ TEST(world, basic) {
     auto e = w.create();
     w.destroy(e);
 }
+
+TEST(world, create_batch_with_components) {
+    world_t w;
+    std::vector<world_t::entity_type> entities(10);
+    w.create<position_t, value_t>(entities.begin(), entities.end());
+
+    for (auto e : entities) {
+        ASSERT_TRUE(w.valid(e));
+        ASSERT_TRUE(w.has<position_t>(e));
+        ASSERT_TRUE(w.has<value_t>(e));
+        ASSERT_FALSE(w.has<motion_t>(e));
+    }
+
+    uint32_t count = 0u;
+    w.view<position_t, value_t>().each([&count](auto&, auto&) {
+        ++count;
+    });
+    ASSERT_EQ(count, entities.size());
+}
+
+TEST(world, destroy_batch) {
+    world_t w;
+    std::vector<world_t::entity_type> entities(10);
+    w.create<position_t>(entities.begin(), entities.end());
+    for (uint32_t i = 0; i < entities.size(); i += 2) {
+        w.assign<value_t>(entities[i]);
+    }
+
+    w.destroy(entities.begin(), entities.begin() + 5);
+
+    ASSERT_EQ(w.pool().size(), 5);
+    ASSERT_EQ(w.pool().available_for_recycling(), 5);
+    for (uint32_t i = 0; i < entities.size(); ++i) {
+        const auto e = entities[i];
+        ASSERT_EQ(w.valid(e), i >= 5);
+        ASSERT_EQ(w.has<position_t>(e), i >= 5);
+        ASSERT_EQ(w.has<value_t>(e), i >= 5 && (i & 1u) == 0u);
+    }
+
+    std::vector<world_t::entity_type> recycled(5);
+    w.create(recycled.begin(), recycled.end());
+    for (auto e : recycled) {
+        ASSERT_TRUE(w.valid(e));
+        ASSERT_FALSE(w.has<position_t>(e));
+    }
+}
+
+TEST(world, wide_entities) {
+    world64_t w;
+    std::vector<world64_t::entity_type> entities(100);
+    w.create<position_t>(entities.begin(), entities.end());
+    w.destroy(entities[10]);
+    auto e = w.create<value_t>();
+    ASSERT_EQ(e.index(), entities[10].index());
+    ASSERT_EQ(e.version(), 1u);
+    ASSERT_FALSE(w.valid(entities[10]));
+    ASSERT_TRUE(w.valid(e));
+    ASSERT_TRUE(w.has<value_t>(e));
+    ASSERT_FALSE(w.has<position_t>(e));
+
+    uint32_t count = 0u;
+    w.view<position_t>().each([&count](auto&) {
+        ++count;
+    });
+    ASSERT_EQ(count, 99u);
+}
+
+TEST(world, compact) {
+    world_t w;
+    std::vector<world_t::entity_type> entities(10000);
+    w.create<position_t>(entities.begin(), entities.end());
+    for (uint32_t i = 0; i < entities.size(); ++i) {
+        w.get<position_t>(entities[i]).x = static_cast<float>(i);
+        if (i % 3 == 0u) {
+            w.assign<value_t>(entities[i], static_cast<int>(i));
+        }
+    }
+    for (uint32_t i = 0; i < entities.size(); ++i) {
+        if (i % 100 != 0u) {
+            w.destroy(entities[i]);
+        }
+    }
+
+    const auto remap = w.compact();
+
+    ASSERT_EQ(w.pool().size(), 100u);
+    ASSERT_EQ(w.pool().available_for_recycling(), 0u);
+    for (uint32_t i = 0; i < entities.size(); i += 100) {
+        const auto old = entities[i];
+        const auto e = remap[old.index()];
+        ASSERT_EQ(e.version(), old.version());
+        ASSERT_EQ(e.index(), i / 100 + 1);
+        ASSERT_TRUE(w.valid(e));
+        ASSERT_EQ(w.get<position_t>(e).x, static_cast<float>(i));
+        ASSERT_EQ(w.has<value_t>(e), i % 3 == 0u);
+        if (i % 3 == 0u) {
+            ASSERT_EQ(w.get<value_t>(e).value, i);
+        }
+    }
+    ASSERT_EQ(remap[entities[1].index()], world_t::entity_type::null);
+
+    auto e = w.create<position_t>();
+    ASSERT_EQ(e.index(), 101u);
+
+    uint32_t count = 0u;
+    w.view<position_t>().each([&count](auto&) {
+        ++count;
+    });
+    ASSERT_EQ(count, 101u);
+}
+
+template<int N>
+struct wide_t {
+    int value;
+};
+
+// more component types than bits in single signature word
+template<int ...N>
+void assign_wide(world_t& w, world_t::entity_type e, std::integer_sequence<int, N...>) {
+    (w.assign<wide_t<N>>(e, N), ...);
+}
+
+template<int ...N>
+size_t count_wide(world_t& w, std::integer_sequence<int, N...>) {
+    size_t count = 0u;
+    (w.view<wide_t<N>>().each([&count](auto&) { ++count; }), ...);
+    return count;
+}
+
+size_t count_position(world_t& w) {
+    size_t count = 0u;
+    w.view<position_t>().each([&count](auto&) { ++count; });
+    return count;
+}
+
+TEST(world, destroy_by_signature) {
+    world_t w;
+    const auto wide = std::make_integer_sequence<int, 100>{};
+    std::vector<world_t::entity_type> entities(10);
+    w.create<position_t>(entities.begin(), entities.end());
+    for (auto e : entities) {
+        assign_wide(w, e, wide);
+    }
+    w.remove<wide_t<99>>(entities[0]);
+    ASSERT_EQ(count_wide(w, wide), 999u);
+
+    w.destroy(entities[0]);
+    ASSERT_EQ(count_wide(w, wide), 900u);
+    ASSERT_FALSE(w.has<position_t>(entities[0]));
+
+    // rows of survivors are moved with entities
+    w.destroy(entities[1]);
+    const auto remap = w.compact();
+    std::vector<world_t::entity_type> survivors;
+    for (size_t i = 2u; i != entities.size(); ++i) {
+        survivors.push_back(remap[entities[i].index()]);
+    }
+    ASSERT_EQ(count_wide(w, wide), 800u);
+
+    w.destroy(survivors.front());
+    ASSERT_EQ(count_wide(w, wide), 700u);
+    ASSERT_EQ(count_position(w), 7u);
+
+    w.destroy(survivors.begin() + 1, survivors.end());
+    ASSERT_EQ(count_wide(w, wide), 0u);
+    ASSERT_EQ(count_position(w), 0u);
+
+    // recycled index starts with empty signature
+    auto e = w.create<position_t>();
+    w.destroy(e);
+    ASSERT_EQ(count_position(w), 0u);
+}
+
+TEST(world, memory_resource) {
+    memory_counter counter;
+    {
+        world_t w{&counter};
+        ASSERT_GT(counter.bytes(), 0u);
+        const auto empty_bytes = counter.bytes();
+
+        std::vector<world_t::entity_type> entities(1000);
+        w.create<position_t, value_t>(entities.begin(), entities.end());
+        ASSERT_GT(counter.bytes(), empty_bytes);
+
+        w.destroy(entities.begin(), entities.end());
+    }
+    ASSERT_EQ(counter.bytes(), 0u);
+    ASSERT_GT(counter.peak(), 0u);
+}
+
+TEST(world, arena) {
+    std::pmr::monotonic_buffer_resource arena;
+    memory_counter counter{&arena};
+    world_t w{&counter};
+    auto e = w.create<position_t>();
+    w.get<position_t>(e).x = 1.0f;
+    ASSERT_EQ(w.get<position_t>(e).x, 1.0f);
+    ASSERT_GT(counter.allocations(), 0u);
+}
+
+struct soa_point_t {
+    float x = 0.0f;
+    int y = 0;
+};
+
+template<>
+struct ecxx::component_traits<soa_point_t> : ecxx::default_component_traits {
+    using soa_layout = ecxx::soa_fields<&soa_point_t::x, &soa_point_t::y>;
+};
+
+TEST(world, get_or_create) {
+    world_t w;
+    auto e = w.create();
+    w.get_or_create<position_t>(e).x = 1.0f;
+    ASSERT_EQ(w.get_or_create<position_t>(e).x, 1.0f);
+
+    // SoA components are gathered by value
+    const soa_point_t created = w.get_or_create<soa_point_t>(e);
+    ASSERT_TRUE(w.has<soa_point_t>(e));
+    ASSERT_EQ(created.y, 0);
+    w.field<&soa_point_t::y>(e) = 2;
+    ASSERT_EQ(w.get_or_create<soa_point_t>(e).y, 2);
+}